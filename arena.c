@@ -0,0 +1,78 @@
+#include "shell.h"
+
+static char *arena_base;
+static size_t arena_size = ARENA_SIZE;
+static size_t arena_used;
+static arena_block_t *arena_extra;
+static size_t arena_extra_size;
+
+/**
+ * arena_alloc - Allocates memory that lives until the current command
+ * has been executed.
+ * @size: The number of bytes needed.
+ * Return: A pointer to the memory.
+ */
+void *arena_alloc(size_t size)
+{
+	arena_block_t *block;
+
+	size = (size + 15) & ~(size_t)15;
+	if (arena_base == NULL)
+	{
+		arena_base = _malloc(arena_size);
+	}
+	if (arena_base != NULL && arena_size - arena_used >= size)
+	{
+		arena_used += size;
+		return (arena_base + arena_used - size);
+	}
+	block = _malloc(sizeof(*block) + size);
+	if (block == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	block->next = arena_extra;
+	arena_extra = block;
+	arena_extra_size += size;
+	return (block + 1);
+}
+
+/**
+ * arena_strdup - Duplicates a string into the command arena.
+ * @str: The string to duplicate.
+ * Return: A pointer to the duplicated string.
+ */
+char *arena_strdup(const char *str)
+{
+	size_t len = _strlen(str) + 1;
+	char *copy = arena_alloc(len);
+
+	_memcpy(copy, str, len);
+	return (copy);
+}
+
+/**
+ * arena_reset - Releases everything allocated for the last command
+ * with a single pointer move. If the command overflowed the arena,
+ * the arena is enlarged so the next one fits.
+ */
+void arena_reset(void)
+{
+	arena_block_t *next;
+
+	arena_used = 0;
+	if (arena_extra == NULL)
+	{
+		return;
+	}
+	for (; arena_extra != NULL; arena_extra = next)
+	{
+		next = arena_extra->next;
+		free(arena_extra);
+	}
+	free(arena_base);
+	arena_base = NULL;
+	arena_size = (arena_size + arena_extra_size) * 2;
+	arena_extra_size = 0;
+}
@@ -0,0 +1,204 @@
+#include "shell.h"
+
+/**
+ * batch_start - Forks a child to run one line of a batch, with its
+ * standard output and error captured in memory files and its
+ * standard input taken from /dev/null.
+ * @job: The job, with its captures open; its process ID is filled in.
+ * @list: The line's command list.
+ * Return: 0 on success, -1 if the job could not be started.
+ */
+static int batch_start(batch_job_t *job, list_node_t *list)
+{
+	int in;
+
+	_flush_out();
+	job->pid = job->out == -1 || job->err == -1 ? -1 : fork();
+	if (job->pid == -1)
+	{
+		perror("batch");
+		return (-1);
+	}
+	if (job->pid == 0)
+	{
+		in = open("/dev/null", O_RDONLY | O_CLOEXEC);
+		if (in != -1)
+		{
+			dup2(in, STDIN_FILENO);
+		}
+		dup2(job->out, STDOUT_FILENO);
+		dup2(job->err, STDERR_FILENO);
+		close(in);
+		close(job->out);
+		close(job->err);
+		set_out_mode(0);
+		run_list(list, get_shell()->progname);
+		_flush_out();
+		_exit(get_shell()->status);
+	}
+	return (0);
+}
+
+/**
+ * batch_add - Reads the next line of a batch into a free job, parses
+ * it and starts it. A syntax error is written to the job's error
+ * capture rather than to the shell's, so it comes out in input order
+ * like the output of the jobs around it.
+ * @job: The free job. Its captures are kept for the next line if this
+ * one is empty, and closed at end of input.
+ * Return: -1 at end of input, 0 for an empty line, or the job's new
+ * state, BATCH_RUNNING or BATCH_DONE.
+ */
+static int batch_add(batch_job_t *job)
+{
+	static int saved_err = -1;
+	char *line = read_line();
+	list_node_t *list;
+	int failed;
+
+	if (line == NULL)
+	{
+		close(job->out);
+		close(job->err);
+		job->out = -1;
+		job->err = -1;
+		return (-1);
+	}
+	get_shell()->line_count++;
+	if (saved_err == -1)
+	{
+		saved_err = fcntl(STDERR_FILENO, F_DUPFD_CLOEXEC, 0);
+	}
+	if (job->out == -1)
+	{
+		job->out = memfd_create("hsh-stdout", MFD_CLOEXEC);
+	}
+	if (job->err == -1)
+	{
+		job->err = memfd_create("hsh-stderr", MFD_CLOEXEC);
+	}
+	dup2(job->err != -1 ? job->err : saved_err, STDERR_FILENO);
+	failed = parse_list(split_input(line), &list) != 0;
+	dup2(saved_err, STDERR_FILENO);
+	job->status = failed ? 2 : 1;
+	job->state = BATCH_DONE;
+	if (!failed && list != NULL && batch_start(job, list) == 0)
+	{
+		job->state = BATCH_RUNNING;
+	}
+	arena_reset();
+	return (failed || list != NULL ? job->state : 0);
+}
+
+/**
+ * batch_emit - Copies a finished job's captured output and errors to
+ * the shell's own, and releases the captures.
+ * @job: The job.
+ * @worst: The highest exit status of the jobs emitted; updated.
+ */
+static void batch_emit(batch_job_t *job, int *worst)
+{
+	if (job->out != -1)
+	{
+		lseek(job->out, 0, SEEK_SET);
+		copy_fd(job->out, STDOUT_FILENO);
+		close(job->out);
+	}
+	if (job->err != -1)
+	{
+		lseek(job->err, 0, SEEK_SET);
+		copy_fd(job->err, STDERR_FILENO);
+		close(job->err);
+	}
+	job->out = -1;
+	job->err = -1;
+	job->state = BATCH_FREE;
+	if (job->status > *worst)
+	{
+		*worst = job->status;
+	}
+}
+
+/**
+ * batch_wait - Blocks until a running job of the batch exits.
+ * @jobs: The ring of jobs.
+ * @window: The size of the ring.
+ * Return: The job that exited, or NULL if there are no children.
+ */
+static batch_job_t *batch_wait(batch_job_t *jobs, int window)
+{
+	pid_t pid;
+	int status, i;
+
+	while ((pid = waitpid(-1, &status, 0)) != -1 || errno == EINTR)
+	{
+		for (i = 0; pid != -1 && i < window; i++)
+		{
+			if (jobs[i].pid != pid
+					|| jobs[i].state != BATCH_RUNNING)
+			{
+				continue;
+			}
+			jobs[i].state = BATCH_DONE;
+			jobs[i].status = wait_status(status);
+			return (&jobs[i]);
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * run_batch - Runs each input line as an independent job, at most
+ * @slots of them at once, and emits each job's output in one piece.
+ *
+ * Jobs are kept in a ring of BATCH_WINDOW jobs per slot. In input order
+ * a finished job waits there until every job before it has been
+ * emitted; a slow job stalls the start of new ones only once the
+ * ring is full.
+ * @slots: The number of jobs to run concurrently.
+ * @unordered: Non-zero to emit each job as soon as it finishes.
+ * Return: The highest exit status of any job.
+ */
+int run_batch(int slots, int unordered)
+{
+	int ring = slots * BATCH_WINDOW, head = 0, next = 0, running = 0;
+	int eof = 0, worst = 0, added;
+	batch_job_t *jobs = _malloc(ring * sizeof(*jobs)), *job;
+
+	for (added = 0; added < ring; added++)
+	{
+		jobs[added].state = BATCH_FREE;
+		jobs[added].out = -1;
+		jobs[added].err = -1;
+	}
+	while (!eof || running > 0)
+	{
+		while (!eof && running < slots && next - head < ring)
+		{
+			added = batch_add(&jobs[next % ring]);
+			eof = added == -1;
+			running += added == BATCH_RUNNING;
+			if (added == BATCH_DONE && unordered)
+			{
+				batch_emit(&jobs[next % ring], &worst);
+			}
+			next += added > 0;
+		}
+		job = running > 0 ? batch_wait(jobs, ring) : NULL;
+		running = job != NULL ? running - 1 : 0;
+		if (job != NULL && unordered)
+		{
+			batch_emit(job, &worst);
+		}
+		for (; head < next && jobs[head % ring].state != BATCH_RUNNING;
+				head++)
+		{
+			if (jobs[head % ring].state == BATCH_DONE)
+			{
+				batch_emit(&jobs[head % ring], &worst);
+			}
+		}
+	}
+	free(jobs);
+	return (worst);
+}
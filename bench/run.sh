@@ -0,0 +1,92 @@
+#!/bin/sh
+# Times each shell given (default ./hsh) on generated workloads and
+# prints the best wall-clock time of three runs, in milliseconds.
+# Usage: [BENCH=workloads] bench/run.sh [shell...]
+#
+#   stdin       200000 blank lines of 60 columns on the standard input:
+#               the line reader alone
+#   lines       100000 echo lines with a variable: reading, expansion,
+#               tokenizing and output buffering
+#   tokens      2000 echo lines of 500 words: the tokenizer
+#   builtins    30000 lines of true, test, printf, pwd and && / ||
+#   test        20000 test -n x, run by the built-in
+#   test-fork   2000 /usr/bin/test -n x, forked
+#   printf      20000 printf %d 42, run by the built-in
+#   printf-fork 2000 /usr/bin/printf %d 42, forked
+#   spawn       2000 PATH-resolved external commands
+#   deeppath    20000 hash -r, hash uname pairs with 32 directories, 16
+#               levels deep each, ahead of /usr/bin on PATH: the lookup
+#   longline    one 16 MB echo line
+#   pipes       500 three-stage pipelines through the cat built-in
+#   jobs        500 background jobs, then wait
+#   batch       2000 lines run with -j 4
+#   parallel    200000 items fanned out by the parallel built-in
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+gen() {
+	awk -v n="$2" -v line="$3" 'BEGIN { for (i = 0; i < n; i++) print line }' \
+		> "$dir/$1"
+}
+awk 'BEGIN { for (i = 0; i < 200000; i++) printf "%60s\n", "" }' \
+	> "$dir/stdin"
+gen lines 100000 'echo alpha $HOME beta gamma delta epsilon'
+gen tokens 2000 "echo$(awk 'BEGIN { for (i = 0; i < 500; i++) printf " w%d", i }')"
+gen builtins 30000 'true && test -n x || false; printf abc; pwd'
+gen test 20000 'test -n x'
+gen test-fork 2000 '/usr/bin/test -n x'
+gen printf 20000 'printf %d 42'
+gen printf-fork 2000 '/usr/bin/printf %d 42'
+gen spawn 2000 'uname -s'
+gen deeppath 20000 'hash -r\nhash uname'
+deep=
+for i in $(seq 32)
+do
+	d=$dir/deep/$i/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o
+	mkdir -p "$d"
+	deep=$deep$d:
+done
+awk 'BEGIN { s = "x"; while (length(s) < 16777216) s = s s; print "echo " s }' \
+	> "$dir/longline"
+gen pipes 500 'uname -s | cat | cat'
+gen jobs 500 'uname -s &'
+echo wait >> "$dir/jobs"
+gen batch 2000 'uname -s'
+seq 200000 > "$dir/items"
+echo 'parallel -n 100 echo' > "$dir/parallel"
+
+# run - Prints the best of three runs of a command with the given input.
+run() {
+	input=$1
+	shift
+	best=
+	for i in 1 2 3
+	do
+		start=$(date +%s%N)
+		"$@" < "$input" > /dev/null 2>&1
+		ms=$((($(date +%s%N) - start) / 1000000))
+		[ -z "$best" ] || [ "$ms" -lt "$best" ] && best=$ms
+	done
+	printf ' %9s' "$best"
+}
+
+[ $# -gt 0 ] || set -- ./hsh
+printf '%-12s' workload
+for sh in "$@"; do printf ' %9s' "${sh##*/}"; done
+echo
+for w in ${BENCH:-stdin lines tokens builtins test test-fork printf printf-fork \
+	spawn deeppath longline pipes jobs batch parallel}
+do
+	printf '%-12s' $w
+	for sh in "$@"
+	do
+		case $w in
+		stdin) run "$dir/stdin" "$sh" ;;
+		batch) run /dev/null "$sh" -j 4 "$dir/batch" ;;
+		parallel) run "$dir/items" "$sh" "$dir/parallel" ;;
+		deeppath) run /dev/null env PATH="$deep/usr/bin:/bin" \
+			"$sh" "$dir/deeppath" ;;
+		*) run /dev/null "$sh" "$dir/$w" ;;
+		esac
+	done
+	echo
+done
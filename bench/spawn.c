@@ -0,0 +1,126 @@
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/*
+ * Launches /bin/true repeatedly with fork() and execve(), the way the
+ * shell used to, and with posix_spawn(), the way it does now, after
+ * growing the heap to each size given. fork() copies the page tables
+ * of the whole heap on every launch; posix_spawn() does not.
+ *
+ * Build and run from the top of the tree:
+ *	gcc -O2 bench/spawn.c -o /tmp/spawn && /tmp/spawn [count [MB...]]
+ */
+
+extern char **environ;
+
+/**
+ * now_ns - Reads the monotonic clock.
+ * Return: The time in nanoseconds.
+ */
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+/**
+ * launch - Runs /bin/true and waits for it.
+ * @use_spawn: Non-zero for posix_spawn(), zero for fork() and execve().
+ * Return: 0 on success, -1 if the command could not be started.
+ */
+static int launch(int use_spawn)
+{
+	char *args[] = {"true", NULL};
+	pid_t pid;
+	int status;
+
+	if (use_spawn)
+	{
+		if (posix_spawn(&pid, "/bin/true", NULL, NULL, args, environ))
+		{
+			return (-1);
+		}
+	}
+	else
+	{
+		pid = fork();
+		if (pid == -1)
+		{
+			return (-1);
+		}
+		if (pid == 0)
+		{
+			execve("/bin/true", args, environ);
+			_exit(127);
+		}
+	}
+	waitpid(pid, &status, 0);
+	return (0);
+}
+
+/**
+ * rate - Measures launches per second with one strategy.
+ * @use_spawn: Non-zero for posix_spawn(), zero for fork() and execve().
+ * @count: The number of launches.
+ * Return: The number of launches per second, or 0 on failure.
+ */
+static double rate(int use_spawn, int count)
+{
+	double start = now_ns();
+	int i;
+
+	for (i = 0; i < count; i++)
+	{
+		if (launch(use_spawn) == -1)
+		{
+			perror("launch");
+			return (0);
+		}
+	}
+	return (count / ((now_ns() - start) / 1e9));
+}
+
+/**
+ * main - Grows the heap to each size in turn and compares the two
+ * launch strategies at that size.
+ * @argc: The number of arguments.
+ * @argv: The launch count, then the heap sizes in megabytes.
+ * Return: 0 on success, 1 if the heap could not be grown.
+ */
+int main(int argc, char **argv)
+{
+	static const char * const sizes[] = {"0", "64", "256", "1024"};
+	int count = argc > 1 ? atoi(argv[1]) : 2000, i, n = argc - 2;
+	const char * const *mb = argc > 2 ? (const char * const *)argv + 2
+		: sizes;
+	size_t grown = 0, want;
+	char *heap;
+
+	n = argc > 2 ? n : (int)(sizeof(sizes) / sizeof(sizes[0]));
+	printf("%8s %14s %14s\n", "heap MB", "fork+execve/s", "posix_spawn/s");
+	for (i = 0; i < n; i++)
+	{
+		want = (size_t)atoi(mb[i]) << 20;
+		if (want > grown)
+		{
+			heap = malloc(want - grown);
+			if (heap == NULL)
+			{
+				perror("malloc");
+				return (1);
+			}
+			memset(heap, 1, want - grown);
+			grown = want;
+		}
+		printf("%8s %14.0f", mb[i], rate(0, count));
+		printf(" %14.0f\n", rate(1, count));
+	}
+	return (0);
+}
@@ -0,0 +1,146 @@
+#include "../shell.h"
+
+/*
+ * Times the shell's string routines against libc's, in nanoseconds per
+ * call, on strings of a few lengths. Each routine scans the whole
+ * string: searches look for a byte that is absent, comparisons compare
+ * equal strings. The strings start one byte past an aligned address, so
+ * the word-at-a-time loops take their unaligned head path.
+ *
+ * Build and run from the top of the tree:
+ *	gcc -O2 bench/strings.c functions[1-4].c memory.c \
+ *		tokenizer.c -o /tmp/strings && /tmp/strings
+ */
+
+#define BENCH_ROUTINES 8
+#define BENCH_BYTES (64L << 20)
+
+static volatile size_t sink;
+static const char * const names[BENCH_ROUTINES] = {
+	"strlen", "strchr", "memchr", "strcmp", "strncmp", "memcpy",
+	"memmove", "scan_delim"
+};
+
+/**
+ * call_shell - Calls one of the shell's routines once.
+ * @which: The routine, an index into names.
+ * @a: A string of @n bytes.
+ * @b: A copy of @a, also used as a destination.
+ * @n: The length of the strings.
+ * Return: Something that depends on the result, to keep the call.
+ */
+static size_t call_shell(int which, const char *a, char *b, size_t n)
+{
+	static delim_set_t set;
+
+	switch (which)
+	{
+	case 0:
+		return (_strlen(a));
+	case 1:
+		return ((size_t)_strchr(a, '!'));
+	case 2:
+		return ((size_t)_memchr(a, '!', n));
+	case 3:
+		return (_strcmp(a, b));
+	case 4:
+		return (_strncmp(a, b, n));
+	case 5:
+		_memcpy(b, a, n);
+		return (0);
+	case 6:
+		_memmove(b, b + 1, n - 1);
+		return (0);
+	}
+	if (!set.compiled)
+	{
+		delim_compile(&set, ";&|<>");
+	}
+	return ((size_t)scan_delim(&set, a));
+}
+
+/**
+ * call_libc - Calls the libc counterpart of one of the routines once.
+ * @which: The routine, an index into names.
+ * @a: A string of @n bytes.
+ * @b: A copy of @a, also used as a destination.
+ * @n: The length of the strings.
+ * Return: Something that depends on the result, to keep the call.
+ */
+static size_t call_libc(int which, const char *a, char *b, size_t n)
+{
+	switch (which)
+	{
+	case 0:
+		return (strlen(a));
+	case 1:
+		return ((size_t)strchr(a, '!'));
+	case 2:
+		return ((size_t)memchr(a, '!', n));
+	case 3:
+		return (strcmp(a, b));
+	case 4:
+		return (strncmp(a, b, n));
+	case 5:
+		return ((size_t)memcpy(b, a, n));
+	case 6:
+		return ((size_t)memmove(b, b + 1, n - 1));
+	}
+	return (strcspn(a, ";&|<>"));
+}
+
+/**
+ * time_routine - Measures one routine on strings of one length.
+ * @which: The routine, an index into names.
+ * @libc: Non-zero for libc's version, zero for the shell's.
+ * @a: A string of @n bytes.
+ * @b: A copy of @a.
+ * @n: The length of the strings.
+ * Return: The time per call in nanoseconds.
+ */
+static double time_routine(int which, int libc, char *a, char *b, size_t n)
+{
+	const char *volatile src = a;
+	long calls = BENCH_BYTES / (long)(n + 16), i;
+	struct timespec t0, t1;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (i = 0; i < calls; i++)
+	{
+		sink += libc ? call_libc(which, src, b, n)
+			: call_shell(which, src, b, n);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	return (((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec))
+			/ calls);
+}
+
+/**
+ * main - Prints a table of the time per call of each routine, the
+ * shell's and libc's, at each length.
+ * Return: Always 0.
+ */
+int main(void)
+{
+	static const size_t lengths[] = {16, 256, 4096, 65536};
+	static char a[65536 + 64], b[65536 + 64];
+	char *sa = a + 1, *sb = b + 1;
+	size_t i, n;
+	int r;
+
+	printf("%-11s %6s %9s %9s\n", "routine", "length", "hsh ns", "libc ns");
+	for (r = 0; r < BENCH_ROUTINES; r++)
+	{
+		for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+		{
+			n = lengths[i];
+			memset(a, 'x', n);
+			a[n] = '\0';
+			memcpy(b, a, n + 1);
+			printf("%-11s %6lu", names[r], (unsigned long)n);
+			printf(" %9.1f", time_routine(r, 0, sa, sb, n - 1));
+			printf(" %9.1f\n", time_routine(r, 1, sa, sb, n - 1));
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,43 @@
+#!/bin/sh
+# Counts the system calls each shell given (default ./hsh) makes on
+# generated workloads, with bench/syscount.c, and prints the total and
+# the writes per line of the workload. Children are not traced, so the
+# counts are the shell's own.
+# Usage: [BENCH=workloads] bench/syscalls.sh [shell...]
+#
+#   echo        1000 echo lines of ten words
+#   env         200 env lines
+#   hits        1000 uname -s, found in the fifth directory of PATH
+#   misses      1000 lines of a command found nowhere on PATH
+cd "$(dirname "$0")/.." || exit 1
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+gcc -O2 bench/syscount.c -o "$dir/syscount" || exit 1
+gen() {
+	awk -v n="$2" -v line="$3" 'BEGIN { for (i = 0; i < n; i++) print line }' \
+		> "$dir/$1"
+}
+gen echo 1000 'echo alpha beta gamma delta epsilon zeta eta theta iota kappa'
+gen env 200 'env'
+gen hits 1000 'uname -s'
+gen misses 1000 'nosuchcommand'
+mkdir "$dir/p1" "$dir/p2" "$dir/p3" "$dir/p4"
+path=$dir/p1:$dir/p2:$dir/p3:$dir/p4:/usr/bin:/bin
+
+[ $# -gt 0 ] || set -- ./hsh
+printf '%-12s' workload
+for sh in "$@"; do printf ' %21s' "${sh##*/} calls/writes"; done
+echo
+for w in ${BENCH:-echo env hits misses}
+do
+	printf '%-12s' $w
+	lines=$(wc -l < "$dir/$w")
+	for sh in "$@"
+	do
+		PATH=$path "$dir/syscount" "$sh" "$dir/$w" \
+			< /dev/null > /dev/null 2> "$dir/out"
+		awk -v n="$lines" '$2 == "total" { t = $1 } $2 == "write" { w = $1 }
+			END { printf " %13.2f %7.2f", t / n, w / n }' "$dir/out"
+	done
+	echo
+done
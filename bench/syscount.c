@@ -0,0 +1,179 @@
+#include <errno.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ptrace.h>
+#include <sys/syscall.h>
+#include <sys/user.h>
+#include <sys/wait.h>
+
+/*
+ * Counts the system calls a command makes, like strace -c, for trees
+ * where strace is not installed. Only the command's own process is
+ * traced: the children it starts are not, so a shell's count is the
+ * cost of the shell itself. x86-64 only.
+ *
+ *	gcc -O2 bench/syscount.c -o /tmp/syscount
+ *	/tmp/syscount ./hsh script.sh
+ *
+ * Prints the total on the first line, then each system call made, most
+ * frequent first, on standard error.
+ */
+
+#define SYSCOUNT_MAX 512
+
+static const struct
+{
+	long nr;
+	const char *name;
+} known[] = {
+	{SYS_read, "read"}, {SYS_write, "write"}, {SYS_writev, "writev"},
+	{SYS_openat, "openat"}, {SYS_close, "close"}, {SYS_fstat, "fstat"},
+	{SYS_newfstatat, "newfstatat"}, {SYS_stat, "stat"},
+	{SYS_access, "access"}, {SYS_faccessat, "faccessat"},
+	{SYS_faccessat2, "faccessat2"}, {SYS_pread64, "pread64"},
+	{SYS_mprotect, "mprotect"},
+	{SYS_lseek, "lseek"}, {SYS_mmap, "mmap"}, {SYS_munmap, "munmap"},
+	{SYS_madvise, "madvise"}, {SYS_brk, "brk"}, {SYS_poll, "poll"},
+	{SYS_clone, "clone"}, {SYS_clone3, "clone3"}, {SYS_fork, "fork"},
+	{SYS_vfork, "vfork"}, {SYS_execve, "execve"}, {SYS_wait4, "wait4"},
+	{SYS_pipe2, "pipe2"}, {SYS_dup2, "dup2"}, {SYS_dup3, "dup3"},
+	{SYS_fcntl, "fcntl"}, {SYS_ioctl, "ioctl"}, {SYS_getpid, "getpid"},
+	{SYS_rt_sigaction, "rt_sigaction"},
+	{SYS_rt_sigprocmask, "rt_sigprocmask"}, {SYS_sendfile, "sendfile"},
+	{SYS_copy_file_range, "copy_file_range"}, {SYS_splice, "splice"},
+	{SYS_getcwd, "getcwd"}, {SYS_chdir, "chdir"}, {SYS_exit_group, "exit"}
+};
+
+/**
+ * syscall_name - Names a system call.
+ * @nr: The system call number.
+ * Return: Its name, or NULL if it is not one this tool knows.
+ */
+static const char *syscall_name(long nr)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(known) / sizeof(known[0]); i++)
+	{
+		if (known[i].nr == nr)
+		{
+			return (known[i].name);
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * trace - Runs a traced child to its end, counting its system calls.
+ * Signals the child receives are passed on to it.
+ * @pid: The child, stopped at its first exec.
+ * @counts: The count of each system call number.
+ * Return: The child's wait status.
+ */
+static int trace(pid_t pid, unsigned long *counts)
+{
+	int status, sig = 0, entering = 1;
+	long nr;
+
+	ptrace(PTRACE_SETOPTIONS, pid, 0, PTRACE_O_TRACESYSGOOD);
+	while (ptrace(PTRACE_SYSCALL, pid, 0, sig) == 0
+			&& waitpid(pid, &status, 0) == pid
+			&& WIFSTOPPED(status))
+	{
+		sig = WSTOPSIG(status);
+		if (sig != (SIGTRAP | 0x80))
+		{
+			sig = sig == SIGTRAP ? 0 : sig;
+			continue;
+		}
+		sig = 0;
+		nr = ptrace(PTRACE_PEEKUSER, pid,
+				offsetof(struct user_regs_struct, orig_rax), 0);
+		if (entering && nr >= 0 && nr < SYSCOUNT_MAX)
+		{
+			counts[nr]++;
+		}
+		entering = !entering;
+	}
+	return (status);
+}
+
+/**
+ * report - Prints the total, then each system call made, most frequent
+ * first.
+ * @counts: The count of each system call number.
+ */
+static void report(unsigned long *counts)
+{
+	unsigned long total = 0, most;
+	long nr, best;
+
+	for (nr = 0; nr < SYSCOUNT_MAX; nr++)
+	{
+		total += counts[nr];
+	}
+	fprintf(stderr, "%10lu total\n", total);
+	for (;;)
+	{
+		for (best = -1, most = 0, nr = 0; nr < SYSCOUNT_MAX; nr++)
+		{
+			if (counts[nr] > most)
+			{
+				most = counts[nr];
+				best = nr;
+			}
+		}
+		if (best == -1)
+		{
+			return;
+		}
+		if (syscall_name(best) != NULL)
+		{
+			fprintf(stderr, "%10lu %s\n", most,
+					syscall_name(best));
+		}
+		else
+		{
+			fprintf(stderr, "%10lu syscall %ld\n", most, best);
+		}
+		counts[best] = 0;
+	}
+}
+
+/**
+ * main - Runs a command under ptrace and reports its system calls.
+ * @argc: The number of arguments.
+ * @argv: The command and its arguments.
+ * Return: The command's exit status, or 127 if it could not be run.
+ */
+int main(int argc, char **argv)
+{
+	static unsigned long counts[SYSCOUNT_MAX];
+	pid_t pid;
+	int status;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: syscount command [arg...]\n");
+		return (2);
+	}
+	pid = fork();
+	if (pid == 0)
+	{
+		ptrace(PTRACE_TRACEME, 0, 0, 0);
+		execvp(argv[1], argv + 1);
+		perror(argv[1]);
+		_exit(127);
+	}
+	if (pid == -1 || waitpid(pid, &status, 0) != pid)
+	{
+		perror("syscount");
+		return (127);
+	}
+	status = trace(pid, counts);
+	report(counts);
+	return (WIFEXITED(status) ? WEXITSTATUS(status) : 128);
+}
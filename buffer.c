@@ -0,0 +1,43 @@
+#include "shell.h"
+
+/**
+ * buf_reserve - Makes sure a buffer can hold a number of bytes.
+ * The capacity grows geometrically, so appending n bytes one piece
+ * at a time costs O(n) copying overall.
+ * @b: The buffer.
+ * @size: The number of bytes needed.
+ */
+void buf_reserve(buf_t *b, size_t size)
+{
+	size_t cap = b->cap ? b->cap : BUFFER_SIZE;
+
+	if (size <= b->cap)
+	{
+		return;
+	}
+	while (cap < size)
+	{
+		cap *= 2;
+	}
+	b->data = _realloc(b->data, b->len, cap);
+	if (b->data == NULL)
+	{
+		perror("Memory allocation error");
+		exit(EXIT_FAILURE);
+	}
+	b->cap = cap;
+}
+
+/**
+ * buf_append - Appends bytes to a buffer, keeping it NUL-terminated.
+ * @b: The buffer.
+ * @s: The bytes to append.
+ * @n: The number of bytes.
+ */
+void buf_append(buf_t *b, const char *s, size_t n)
+{
+	buf_reserve(b, b->len + n + 1);
+	_memcpy(b->data + b->len, s, n);
+	b->len += n;
+	b->data[b->len] = '\0';
+}
@@ -1,173 +1,140 @@
 #include "shell.h"
 
 /**
- * split_input - Splits a string into tokens.
- * @input: The input string to be split.
- *
- * Return: An array of pointers to the tokens.
+ * token_push - Appends a pointer to an array of tokens, doubling the
+ * array in the command arena when it is full. The array is kept
+ * NULL-terminated.
+ * @tokens: The array.
+ * @count: The number of tokens in the array; incremented.
+ * @size: The capacity of the array; updated when it grows.
+ * @token: The token to append.
+ * Return: The array, which may have moved.
  */
-char **split_input(char *input)
+char **token_push(char **tokens, int *count, int *size, char *token)
 {
-	int buffer_size = BUFFER_SIZE;
-	int position = 0;
-	char **tokens = malloc(buffer_size * sizeof(char *));
-	char *token, *save_ptr;
-
-	if (!tokens)
-	{
-		perror("Memory allocation error");
-		exit(EXIT_FAILURE);
-	}
+	char **grown;
 
-	token = _strtok(input, " \t\r\n\a\"", &save_ptr);
-	while (token != NULL)
+	tokens[(*count)++] = token;
+	if (*count >= *size)
 	{
-		tokens[position] = token;
-		position++;
-		if (position >= buffer_size)
-		{
-			buffer_size += BUFFER_SIZE;
-			tokens = _realloc(tokens, buffer_size * sizeof(char *));
-			if (!tokens)
-			{
-				perror("Memory allocation error");
-				exit(EXIT_FAILURE);
-			}
-		}
-		token = _strtok(NULL, " \t\r\n\a\"", &save_ptr);
+		*size *= 2;
+		grown = arena_alloc(*size * sizeof(char *));
+		_memcpy((char *)grown, (char *)tokens, *count * sizeof(char *));
+		tokens = grown;
 	}
-	tokens[position] = NULL;
+	tokens[*count] = NULL;
 	return (tokens);
 }
 
 /**
- * get_full_path - Returns the full path of a command.
- * @command: The command to find the full path for.
- * Return: A pointer to the full path string, or NULL if not found.
+ * word_end - Finds the end of a word: the first blank or operator
+ * after its first character.
+ * @p: The first character of the word.
+ * @stops: The blanks and the characters operators start with.
+ * @blanks: The blanks.
+ * Return: The end of the word.
  */
-char *get_full_path(const char *command)
+static char *word_end(char *p, const delim_set_t *stops,
+		const delim_set_t *blanks)
 {
-	char *full_path = NULL;
-	char *path_env, *path_copy, *save_ptr, *path_token;
-
-	if (_strchr(command, '/') != NULL)
-	{
-		full_path = _strdup(command);
-	} else
-	{
-		path_env = _getenv("PATH");
-		path_copy = _strdup(path_env);
-		path_token = _strtok(path_copy, ":", &save_ptr);
-
-		while (path_token != NULL)
-		{
-			full_path = malloc(_strlen(path_token) + _strlen(command) + 2);
-			if (full_path == NULL)
-			{
-				perror("Memory allocation error");
-				exit(EXIT_FAILURE);
-			}
-			_strcpy(full_path, path_token);
-			_strcat(full_path, "/");
-			_strcat(full_path, command);
-
-			if (access(full_path, X_OK) == 0)
-			{
-				break;
-			}
-			free(full_path);
-			full_path = NULL;
-			path_token = _strtok(NULL, ":", &save_ptr);
-		}
-		free(path_copy);
-	}
-
-	return (full_path);
+	do {
+		p += scan_delim(stops, p + 1) - p;
+	} while (*p != '\0' && !DELIM_HAS(blanks, *p)
+			&& lex_operator(p) == NULL);
+	return (p);
 }
 
 /**
- * cmd_check - Checks and executes various built-in commands
- * or external programs.
- * @args: An array of command arguments.
- * @progname: The name of the program.
+ * split_input - Splits a command line into words and operators.
+ * @input: The input string to be split; each word is terminated
+ * in place.
+ *
+ * Operators need not be surrounded by blanks. They are stored as
+ * pointers to the strings lex_operator() returns, so words never
+ * compare equal to them.
+ * Return: An array of pointers to the tokens, allocated in the
+ * command arena.
  */
-void cmd_check(char **args, const char *progname)
+char **split_input(char *input)
 {
-	if (args[0] != NULL)
+	static delim_set_t blanks, stops;
+	int size = BUFFER_SIZE, count = 0;
+	char **tokens = arena_alloc(size * sizeof(char *));
+	const char *op;
+	char *p = input, *start;
+
+	if (!blanks.compiled)
 	{
-		if (args[0][0] == '$')
-		{
-			handle_special_env(args[0] + 1, progname);
-		}
-		else if (_strcmp(args[0], "setenv") == 0)
-		{
-			handle_setenv(args);
-		}
-		else if (_strcmp(args[0], "unsetenv") == 0)
-		{
-			handle_unsetenv(args);
-		}
-		else if (_strcmp(args[0], "exit") == 0)
+		delim_compile(&blanks, BLANK_CHARS);
+		delim_compile(&stops, BLANK_CHARS OPERATOR_CHARS);
+	}
+	tokens[0] = NULL;
+	while (*p != '\0')
+	{
+		if (DELIM_HAS(&blanks, *p))
 		{
-			handle_exit(args);
+			p++;
+			continue;
 		}
-		else if (_strcmp(args[0], "echo") == 0)
+		op = lex_operator(p);
+		if (op == NULL)
 		{
-			execute_echo(args);
+			start = p;
+			p = word_end(p, &stops, &blanks);
+			tokens = token_push(tokens, &count, &size, start);
+			op = lex_operator(p);
+			if (*p != '\0' && op == NULL)
+			{
+				*p++ = '\0';
+			}
 		}
-		else
+		if (op != NULL)
 		{
-			execute_command(args, progname);
+			tokens = token_push(tokens, &count, &size, (char *)op);
+			*p = '\0';
+			p += _strlen(op);
 		}
 	}
+	return (tokens);
 }
 
 /**
- * execute_external_command - Executes an external command.
- * @args: An array of command arguments.
- * @full_path: The full path of the command to execute.
+ * cmd_check - Checks and executes various built-in commands
+ * or external programs.
+ * @cmd: The command, with its arguments not yet expanded.
+ * @progname: The name of the program.
+ * Return: The exit status of the command, 2 if a redirection failed,
+ * or the previous status if the command expanded to nothing.
  */
-void execute_external_command(char **args, const char *full_path)
+int cmd_check(cmd_t *cmd, const char *progname)
 {
-	pid_t pid;
-	int status;
+	const builtin_t *builtin = NULL;
+	unsigned long start = TRACE_START();
+	char **args = expand_args(cmd->args);
+	int status = get_shell()->status;
 
-	pid = fork();
-	if (pid == 0)
-	{
-		if (execve(full_path, args, environ) == -1)
-		{
-			perror("Error");
-		}
-		exit(EXIT_FAILURE);
-	} else if (pid < 0)
-	{
-		perror("Error forking");
-	} else
+	TRACE_END(TRACE_EXPAND, start);
+	start = TRACE_START();
+	if (open_redirs(cmd->redirs) != 0)
 	{
-		do {
-			waitpid(pid, &status, WUNTRACED);
-		} while (!WIFEXITED(status) && !WIFSIGNALED(status));
+		return (2);
 	}
-	free((char *)full_path);
-}
-
-/**
- * execute_command - Executes a command
- * either built-in or external.
- * @args: An array of command arguments.
- * @progname: The name of the program.
- */
-void execute_command(char **args, const char *progname)
-{
-	char *command = args[0];
-	char *full_path = get_full_path(command);
-
-	if (full_path != NULL)
+	if (args[0] != NULL)
 	{
-		execute_external_command(args, full_path);
-	} else
+		builtin = find_builtin(args[0]);
+	}
+	TRACE_END(TRACE_DISPATCH, start);
+	if (args[0] != NULL)
 	{
-		print_err(progname, "not found", args[0]);
+		if (builtin != NULL)
+		{
+			status = run_builtin(builtin, args, cmd->redirs);
+		}
+		else
+		{
+			status = execute_command(args, cmd->redirs, progname);
+		}
 	}
+	close_redirs(cmd->redirs);
+	return (status);
 }
@@ -0,0 +1,89 @@
+#include "shell.h"
+
+/**
+ * handle_true - Handles the 'true' and ':' built-in commands.
+ * @args: Array of command arguments (unused).
+ * Return: Always 0.
+ */
+int handle_true(char **args)
+{
+	(void)args;
+	return (0);
+}
+
+/**
+ * handle_false - Handles the 'false' built-in command.
+ * @args: Array of command arguments (unused).
+ * Return: Always 1.
+ */
+int handle_false(char **args)
+{
+	(void)args;
+	return (1);
+}
+
+/**
+ * handle_pwd - Handles the 'pwd' built-in command.
+ * @args: Array of command arguments (unused).
+ * Return: 0 on success, 1 if the current directory cannot be found.
+ */
+int handle_pwd(char **args)
+{
+	char cwd[PATH_MAX];
+
+	(void)args;
+	if (getcwd(cwd, sizeof(cwd)) == NULL)
+	{
+		perror("pwd");
+		return (1);
+	}
+	_puts(cwd);
+	return (0);
+}
+
+/**
+ * handle_cd - Handles the 'cd' built-in command.
+ * With no argument, changes to $HOME; with '-', changes to $OLDPWD
+ * and prints it. PWD and OLDPWD are updated on success.
+ * @args: Array of command arguments.
+ * Return: 0 on success, 2 if the directory cannot be entered.
+ */
+int handle_cd(char **args)
+{
+	char old[PATH_MAX], cwd[PATH_MAX];
+	const char *dir = args[1];
+	int dash = dir != NULL && _strcmp(dir, "-") == 0;
+
+	if (dir == NULL)
+	{
+		dir = _getenv("HOME");
+	}
+	else if (dash)
+	{
+		dir = _getenv("OLDPWD");
+	}
+	if (dir == NULL)
+	{
+		dir = dash ? "" : "/";
+	}
+	if (getcwd(old, sizeof(old)) == NULL)
+	{
+		old[0] = '\0';
+	}
+	if (chdir(dir) == -1)
+	{
+		builtin_err("cd", "can't cd to ", dir);
+		return (2);
+	}
+	if (getcwd(cwd, sizeof(cwd)) == NULL)
+	{
+		_strcpy(cwd, dir);
+	}
+	env_put("OLDPWD", old);
+	env_put("PWD", cwd);
+	if (dash)
+	{
+		_puts(cwd);
+	}
+	return (0);
+}
@@ -0,0 +1,165 @@
+#include "shell.h"
+
+/**
+ * copy_in_kernel - Moves data between two descriptors without it
+ * passing through user space, using the first of copy_file_range(),
+ * sendfile() and splice() that the pair of descriptors supports.
+ * @in: The descriptor to read from.
+ * @out: The descriptor to write to.
+ * Return: 0 at end of input, 1 if no zero-copy method applies (some
+ * data may already have been moved), -1 on a real error.
+ */
+static int copy_in_kernel(int in, int out)
+{
+	ssize_t n;
+	int method;
+
+	for (method = 0; method < 3; method++)
+	{
+		do {
+			if (method == 0)
+			{
+				n = copy_file_range(in, NULL, out, NULL,
+						CAT_CHUNK, 0);
+			}
+			else if (method == 1)
+			{
+				n = sendfile(out, in, NULL, CAT_CHUNK);
+			}
+			else
+			{
+				n = splice(in, NULL, out, NULL, CAT_CHUNK,
+						SPLICE_F_MOVE);
+			}
+		} while (n > 0 || (n == -1 && errno == EINTR));
+		if (n == 0)
+		{
+			return (0);
+		}
+		if (errno != EINVAL && errno != EXDEV && errno != ENOSYS
+				&& errno != EBADF && errno != EOPNOTSUPP)
+		{
+			return (-1);
+		}
+	}
+	return (1);
+}
+
+/**
+ * copy_by_read - Copies the rest of the input with read() and write().
+ * @in: The descriptor to read from.
+ * @out: The descriptor to write to.
+ * Return: 0 at end of input, -1 on an error.
+ */
+static int copy_by_read(int in, int out)
+{
+	char buf[BUFSIZ];
+	ssize_t n, done, w;
+
+	while ((n = read(in, buf, sizeof(buf))) != 0)
+	{
+		if (n == -1 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n == -1)
+		{
+			return (-1);
+		}
+		for (done = 0; done < n; done += w)
+		{
+			w = write(out, buf + done, n - done);
+			if (w == -1 && errno != EINTR)
+			{
+				return (-1);
+			}
+			w = w == -1 ? 0 : w;
+		}
+	}
+	return (0);
+}
+
+/**
+ * cat_error - Reports a file that could not be copied.
+ * @name: The file name.
+ * @reason: Why, usually strerror(errno).
+ */
+static void cat_error(const char *name, const char *reason)
+{
+	char *detail = arena_alloc(_strlen(reason) + 3);
+
+	_strcpy(detail, ": ");
+	_strcat(detail, reason);
+	builtin_err("cat", name, detail);
+}
+
+/**
+ * copy_fd - Copies everything left in one descriptor to another,
+ * inside the kernel when the pair of descriptors allows it.
+ * @in: The descriptor to read from.
+ * @out: The descriptor to write to.
+ * Return: 0 on success, -1 on an error (errno is set).
+ */
+int copy_fd(int in, int out)
+{
+	int copied = copy_in_kernel(in, out);
+
+	if (copied == 1)
+	{
+		copied = copy_by_read(in, out);
+	}
+	return (copied);
+}
+
+/**
+ * handle_cat - Handles the 'cat' built-in command: copies each file,
+ * or the standard input for "-" or no file, to the standard output.
+ *
+ * The data is moved by the kernel wherever it can be, so a file sent
+ * to a redirected output or a pipe never passes through the shell.
+ * A file that is also the output is refused, as it would grow without
+ * end; options are left to the external cat.
+ * @args: Array of command arguments.
+ * Return: 0 on success, 1 if any file could not be read or written,
+ * or BUILTIN_EXTERNAL if an option was given.
+ */
+int handle_cat(char **args)
+{
+	int i = 1, in, status = 0, copied, out_reg;
+	struct stat out_st, in_st;
+	const char *name;
+
+	if (args[1] != NULL && args[1][0] == '-' && args[1][1] != '\0')
+	{
+		return (BUILTIN_EXTERNAL);
+	}
+	_flush_out();
+	out_reg = fstat(STDOUT_FILENO, &out_st) == 0
+		&& S_ISREG(out_st.st_mode);
+	do {
+		name = args[1] == NULL ? "-" : args[i];
+		in = _strcmp(name, "-") == 0 ? STDIN_FILENO
+			: open(name, O_RDONLY | O_CLOEXEC);
+		if (in != -1 && out_reg && fstat(in, &in_st) == 0
+				&& in_st.st_dev == out_st.st_dev
+				&& in_st.st_ino == out_st.st_ino)
+		{
+			cat_error(name, "input file is output file");
+			status = 1;
+		}
+		else
+		{
+			copied = in == -1 ? -1 : copy_fd(in, STDOUT_FILENO);
+			if (copied == -1)
+			{
+				cat_error(name, strerror(errno));
+				status = 1;
+			}
+		}
+		if (in != -1 && in != STDIN_FILENO)
+		{
+			close(in);
+		}
+	} while (args[1] != NULL && args[++i] != NULL);
+	return (status);
+}
@@ -0,0 +1,135 @@
+#include "shell.h"
+
+/*
+ * The built-in commands, and a perfect hash of their names: slot
+ * builtin_hash(name) of builtin_slots holds the 1-based index of the
+ * built-in, or 0. The table is built on the first lookup by trying
+ * multipliers until no two names collide. The hash covers every byte
+ * of the name, so any set of distinct names can be separated; should
+ * the search still fail, lookups fall back to a linear scan rather
+ * than to a wrong table.
+ */
+static const builtin_t builtins[] = {
+	{"setenv", handle_setenv},
+	{"unsetenv", handle_unsetenv},
+	{"exit", handle_exit},
+	{"echo", execute_echo},
+	{"hash", handle_hash},
+	{"env", handle_env},
+	{"true", handle_true},
+	{"false", handle_false},
+	{":", handle_true},
+	{"test", handle_test},
+	{"[", handle_test},
+	{"printf", handle_printf},
+	{"pwd", handle_pwd},
+	{"cd", handle_cd},
+	{"cat", handle_cat},
+	{"wait", handle_wait},
+	{"jobs", handle_jobs},
+	{"parallel", handle_parallel}
+};
+
+static unsigned char builtin_slots[BUILTIN_SLOTS_MAX];
+static unsigned int hash_a, hash_b, slot_count;
+static int table_state;
+
+/**
+ * builtin_hash - Hashes a command name onto a built-in slot.
+ * @name: The command name.
+ * Return: The slot index.
+ */
+static unsigned int builtin_hash(const char *name)
+{
+	unsigned int h = hash_b;
+
+	for (; *name != '\0'; name++)
+	{
+		h = (h ^ (unsigned char)*name) * hash_a;
+	}
+	return ((h ^ (h >> 16)) & (slot_count - 1));
+}
+
+/**
+ * builtin_table_fill - Fills the slot table with the current
+ * multipliers and table size.
+ * Return: 1 if no two built-ins collided, 0 otherwise.
+ */
+static int builtin_table_fill(void)
+{
+	unsigned int i, slot;
+
+	for (slot = 0; slot < slot_count; slot++)
+	{
+		builtin_slots[slot] = 0;
+	}
+	for (i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++)
+	{
+		slot = builtin_hash(builtins[i].name);
+		if (builtin_slots[slot] != 0)
+		{
+			return (0);
+		}
+		builtin_slots[slot] = i + 1;
+	}
+	return (1);
+}
+
+/**
+ * builtin_table_build - Searches for multipliers that hash the
+ * built-ins without collisions, in the smallest table that allows it,
+ * and records whether lookups can use the table.
+ */
+static void builtin_table_build(void)
+{
+	table_state = TABLE_LINEAR;
+	for (slot_count = BUILTIN_SLOTS; slot_count <= BUILTIN_SLOTS_MAX;
+			slot_count *= 2)
+	{
+		for (hash_a = 1; hash_a < BUILTIN_HASH_TRIES * 2; hash_a += 2)
+		{
+			for (hash_b = 0; hash_b < BUILTIN_HASH_TRIES; hash_b++)
+			{
+				if (builtin_table_fill())
+				{
+					table_state = TABLE_HASHED;
+					return;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * find_builtin - Looks up a built-in command by name, with one hash
+ * and at most one string comparison whatever the number of built-ins.
+ * @name: The command name.
+ * Return: The built-in, or NULL if @name is not one.
+ */
+const builtin_t *find_builtin(const char *name)
+{
+	unsigned int i;
+	int index;
+
+	if (table_state == 0)
+	{
+		builtin_table_build();
+	}
+	if (table_state == TABLE_LINEAR)
+	{
+		for (i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++)
+		{
+			if (_strcmp(builtins[i].name, name) == 0)
+			{
+				return (&builtins[i]);
+			}
+		}
+		return (NULL);
+	}
+	index = builtin_slots[builtin_hash(name)];
+	if (index == 0 || _strcmp(builtins[index - 1].name, name) != 0)
+	{
+		return (NULL);
+	}
+	return (&builtins[index - 1]);
+}
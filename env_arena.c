@@ -0,0 +1,137 @@
+#include "shell.h"
+
+/**
+ * env_chunk_new - Allocates an arena chunk for environment strings.
+ * @min_size: The minimum number of bytes the chunk must hold.
+ * Return: The new chunk, or NULL on allocation failure.
+ */
+static env_chunk_t *env_chunk_new(size_t min_size)
+{
+	size_t size = min_size > ENV_CHUNK_SIZE ? min_size : ENV_CHUNK_SIZE;
+	env_chunk_t *chunk = _malloc(sizeof(*chunk) + size);
+
+	if (chunk != NULL)
+	{
+		chunk->size = size;
+		chunk->used = 0;
+		chunk->next = NULL;
+	}
+	return (chunk);
+}
+
+/**
+ * env_compact - Copies the live environment strings into a fresh
+ * arena and releases the old one, once replaced and removed strings
+ * take up more room than the live ones. Values previously returned by
+ * _getenv() are invalidated.
+ */
+void env_compact(void)
+{
+	env_store_t *store = get_env_store();
+	env_chunk_t *old = store->chunks, *next;
+	env_var_t *var;
+	size_t len;
+	char *copy;
+
+	if (store->used - store->live <= store->live + ENV_CHUNK_SIZE)
+	{
+		return;
+	}
+	store->chunks = env_chunk_new(store->live);
+	if (store->chunks == NULL)
+	{
+		store->chunks = old;
+		return;
+	}
+	store->used = 0;
+	for (var = store->first; var != NULL; var = var->after)
+	{
+		len = _strlen(var->entry) + 1;
+		copy = (char *)(store->chunks + 1) + store->used;
+		_memcpy(copy, var->entry, len);
+		var->entry = copy;
+		store->used += len;
+	}
+	store->chunks->used = store->used;
+	for (; old != NULL; old = next)
+	{
+		next = old->next;
+		free(old);
+	}
+	store->generation++;
+}
+
+/**
+ * env_arena_alloc - Allocates room for an environment string.
+ * @size: The number of bytes needed.
+ * Return: A pointer to the room, or NULL on allocation failure.
+ */
+char *env_arena_alloc(size_t size)
+{
+	env_store_t *store = get_env_store();
+	env_chunk_t *chunk = store->chunks;
+
+	if (chunk == NULL || chunk->size - chunk->used < size)
+	{
+		chunk = env_chunk_new(size);
+		if (chunk == NULL)
+		{
+			return (NULL);
+		}
+		chunk->next = store->chunks;
+		store->chunks = chunk;
+	}
+	chunk->used += size;
+	store->used += size;
+	return ((char *)(chunk + 1) + chunk->used - size);
+}
+
+/**
+ * env_envp - Returns the environment as a NULL-terminated array for
+ * execve(). The array is only rebuilt when the store has changed
+ * since it was last built.
+ * Return: The environment array.
+ */
+char **env_envp(void)
+{
+	env_store_t *store = get_env_store();
+	env_var_t *var;
+	char *end = NULL;
+
+	if (store->envp.data != NULL
+			&& store->envp_generation == store->generation)
+	{
+		return ((char **)store->envp.data);
+	}
+	store->envp.len = 0;
+	for (var = store->first; var != NULL; var = var->after)
+	{
+		buf_append(&store->envp, (char *)&var->entry, sizeof(char *));
+	}
+	buf_append(&store->envp, (char *)&end, sizeof(char *));
+	store->envp_generation = store->generation;
+	return ((char **)store->envp.data);
+}
+
+/**
+ * env_init - Imports the inherited environment into the store.
+ */
+void env_init(void)
+{
+	char **env, *eq;
+	char name[BUFFER_SIZE];
+	size_t len;
+
+	for (env = environ; *env != NULL; env++)
+	{
+		eq = _strchr(*env, '=');
+		len = eq != NULL ? (size_t)(eq - *env) : 0;
+		if (len == 0 || len >= BUFFER_SIZE)
+		{
+			continue;
+		}
+		_memcpy(name, *env, len);
+		name[len] = '\0';
+		env_put(name, eq + 1);
+	}
+}
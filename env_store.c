@@ -0,0 +1,142 @@
+#include "shell.h"
+
+/**
+ * get_env_store - Returns the shell's environment store.
+ * Return: A pointer to the store.
+ */
+env_store_t *get_env_store(void)
+{
+	static env_store_t store;
+
+	return (&store);
+}
+
+/**
+ * env_hash - Computes the bucket of a variable name.
+ * @name: The variable name (not necessarily NUL-terminated).
+ * @len: The length of the name.
+ * Return: The bucket index.
+ */
+static unsigned int env_hash(const char *name, size_t len)
+{
+	unsigned int h = 5381;
+
+	while (len > 0)
+	{
+		h = h * 33 + (unsigned char)*name;
+		name++;
+		len--;
+	}
+	return (h % ENV_BUCKETS);
+}
+
+/**
+ * env_find - Looks up a variable in the environment store.
+ * @name: The variable name (not necessarily NUL-terminated).
+ * @len: The length of the name.
+ * Return: The variable, or NULL if it is not set.
+ */
+env_var_t *env_find(const char *name, size_t len)
+{
+	env_var_t *var = get_env_store()->buckets[env_hash(name, len)];
+
+	while (var != NULL && (var->name_len != len
+				|| _strncmp(var->entry, name, len) != 0))
+	{
+		var = var->next;
+	}
+	return (var);
+}
+
+/**
+ * env_put - Sets a variable in the environment store.
+ * @name: The variable name.
+ * @value: The value to assign.
+ * Return: True if successful, false on allocation failure.
+ */
+bool env_put(const char *name, const char *value)
+{
+	env_store_t *store = get_env_store();
+	size_t name_len = _strlen(name), value_len = _strlen(value);
+	env_var_t *var = env_find(name, name_len);
+	char *entry = env_arena_alloc(name_len + value_len + 2);
+
+	if (entry == NULL)
+	{
+		return (false);
+	}
+	_memcpy(entry, name, name_len);
+	entry[name_len] = '=';
+	_memcpy(entry + name_len + 1, value, value_len + 1);
+	if (var == NULL)
+	{
+		var = _malloc(sizeof(*var));
+		if (var == NULL)
+		{
+			return (false);
+		}
+		var->name_len = name_len;
+		var->next = store->buckets[env_hash(name, name_len)];
+		store->buckets[env_hash(name, name_len)] = var;
+		var->after = NULL;
+		var->before = store->last;
+		*(var->before != NULL ? &var->before->after
+				: &store->first) = var;
+		store->last = var;
+		store->count++;
+	}
+	else
+	{
+		store->live -= _strlen(var->entry) + 1;
+	}
+	var->entry = entry;
+	store->live += name_len + value_len + 2;
+	store->generation++;
+	env_compact();
+	return (true);
+}
+
+/**
+ * env_remove - Removes a variable from the environment store.
+ * @name: The variable name.
+ * Return: True if the variable was removed, false if it was not set.
+ */
+bool env_remove(const char *name)
+{
+	env_store_t *store = get_env_store();
+	size_t len = _strlen(name);
+	env_var_t **link = &store->buckets[env_hash(name, len)];
+	env_var_t *var = env_find(name, len);
+
+	if (var == NULL)
+	{
+		return (false);
+	}
+	while (*link != var)
+	{
+		link = &(*link)->next;
+	}
+	*link = var->next;
+	if (var->before != NULL)
+	{
+		var->before->after = var->after;
+	}
+	else
+	{
+		store->first = var->after;
+	}
+	if (var->after != NULL)
+	{
+		var->after->before = var->before;
+	}
+	else
+	{
+		store->last = var->before;
+	}
+	store->live -= _strlen(var->entry) + 1;
+	store->count--;
+	store->generation++;
+	free(var);
+	env_compact();
+	return (true);
+}
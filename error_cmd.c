@@ -0,0 +1,46 @@
+#include "shell.h"
+
+/**
+ * cmd_err - Prints an error message about a command where the command's
+ * own standard error would go, so that "cmd 2>/dev/null" silences it.
+ * @progname: The name of the program.
+ * @redirs: The command's redirections, already opened.
+ * @out: The descriptor the command's standard output goes to before its
+ * redirections, for "2>&1".
+ * @cmd: The command.
+ * @message: The error message.
+ */
+void cmd_err(const char *progname, redir_t *redirs, int out,
+		const char *cmd, const char *message)
+{
+	int err_fd = STDERR_FILENO, saved;
+
+	for (; redirs != NULL; redirs = redirs->next)
+	{
+		if (redirs->fd == STDOUT_FILENO)
+		{
+			out = redirs->source;
+		}
+		else if (redirs->fd == STDERR_FILENO)
+		{
+			err_fd = redirs->kind == REDIR_DUP ? out
+				: redirs->source;
+		}
+	}
+	if (err_fd == STDERR_FILENO)
+	{
+		print_err(progname, message, cmd);
+		return;
+	}
+	_flush_out();
+	saved = fcntl(STDERR_FILENO, F_DUPFD_CLOEXEC, 10);
+	dup2(err_fd, STDERR_FILENO);
+	print_err(progname, message, cmd);
+	if (saved == -1)
+	{
+		close(STDERR_FILENO);
+		return;
+	}
+	dup2(saved, STDERR_FILENO);
+	close(saved);
+}
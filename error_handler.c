@@ -1,5 +1,43 @@
 #include "shell.h"
 
+/**
+ * write_err - Writes a diagnostic to the standard error stream
+ * with a single writev() call, so it cannot interleave with
+ * output from other processes.
+ * @parts: The strings making up the message.
+ * @count: The number of strings in @parts (at most ERR_PARTS_MAX).
+ */
+void write_err(const char **parts, int count)
+{
+	struct iovec iov[ERR_PARTS_MAX];
+	int i;
+
+	_flush_out();
+	for (i = 0; i < count && i < ERR_PARTS_MAX; i++)
+	{
+		iov[i].iov_base = (void *)parts[i];
+		iov[i].iov_len = _strlen(parts[i]);
+	}
+	writev(STDERR_FILENO, iov, i);
+}
+
+/**
+ * err_prefix - Starts a diagnostic with the "progname: line: " prefix
+ * that every message of the shell carries.
+ * @parts: The message parts; the first ERR_PREFIX_PARTS are filled in.
+ * @progname: The name of the program.
+ * @line: A buffer of ITOA_SIZE bytes for the line number.
+ * Return: ERR_PREFIX_PARTS, the number of parts filled in.
+ */
+int err_prefix(const char **parts, const char *progname, char *line)
+{
+	parts[0] = progname;
+	parts[1] = ": ";
+	parts[2] = _itoa(get_shell()->line_count, line);
+	parts[3] = ": ";
+	return (ERR_PREFIX_PARTS);
+}
+
 /**
  * print_err - Prints an error message to the standard error stream.
  * @progname: The name of the program.
@@ -8,21 +46,15 @@
  */
 void print_err(const char *progname, const char *message, const char *cmd)
 {
-	char *count_str = NULL;
-	char *colon = ": ";
-	char *newline = "\n";
-
-	write(STDERR_FILENO, progname, _strlen(progname));
-	write(STDERR_FILENO, colon, _strlen(colon));
+	const char *parts[8];
+	char line[ITOA_SIZE];
+	int n = err_prefix(parts, progname, line);
 
-	count_str = _itoa(1);
-	write(STDERR_FILENO, count_str, _strlen(count_str));
-
-	write(STDERR_FILENO, colon, _strlen(colon));
-	write(STDERR_FILENO, cmd, _strlen(cmd));
-	write(STDERR_FILENO, colon, _strlen(colon));
-	write(STDERR_FILENO, message, _strlen(message));
-	write(STDERR_FILENO, newline, _strlen(newline));
+	parts[n++] = cmd;
+	parts[n++] = ": ";
+	parts[n++] = message;
+	parts[n++] = "\n";
+	write_err(parts, n);
 }
 
 /**
@@ -32,7 +64,26 @@ void print_err(const char *progname, const char *message, const char *cmd)
  */
 void print_custom_err(const char *message)
 {
-	size_t len = _strlen(message);
+	write_err(&message, 1);
+}
+
+/**
+ * builtin_err - Prints a built-in command's error message to the
+ * standard error stream, prefixed like print_err().
+ * @name: The built-in command's name.
+ * @msg: The first part of the message.
+ * @detail: The rest of the message.
+ */
+void builtin_err(const char *name, const char *msg, const char *detail)
+{
+	const char *parts[9];
+	char line[ITOA_SIZE];
+	int n = err_prefix(parts, get_shell()->progname, line);
 
-	write(STDERR_FILENO, message, len);
+	parts[n++] = name;
+	parts[n++] = ": ";
+	parts[n++] = msg;
+	parts[n++] = detail;
+	parts[n++] = "\n";
+	write_err(parts, n);
 }
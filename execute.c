@@ -0,0 +1,173 @@
+#include "shell.h"
+
+/**
+ * wait_status - Converts a waitpid() status to a shell exit status.
+ * @status: The status reported by waitpid().
+ * Return: The exit code, or 128 plus the signal number if the
+ * process was killed by a signal.
+ */
+int wait_status(int status)
+{
+	if (WIFSIGNALED(status))
+	{
+		return (128 + WTERMSIG(status));
+	}
+	return (WEXITSTATUS(status));
+}
+
+/**
+ * spawn_command - Starts an external command without waiting for it.
+ *
+ * The child is started with posix_spawn(), which shares the shell's
+ * address space until the exec instead of copying its page tables.
+ * A failure to start it is reported like the shell's other
+ * diagnostics, "progname: line: command: reason", where the command's
+ * standard error goes.
+ * @args: An array of command arguments.
+ * @full_path: The full path of the command to execute.
+ * @in: The descriptor to use as the command's standard input.
+ * @out: The descriptor to use as the command's standard output.
+ * @redirs: The command's redirections, already opened; applied after
+ * @in and @out.
+ * @pid: Where to store the process ID.
+ * Return: 0 on success; 127 if the command could not be found and
+ * 126 if it could not be executed.
+ */
+int spawn_command(char **args, const char *full_path, int in, int out,
+		redir_t *redirs, pid_t *pid)
+{
+	posix_spawn_file_actions_t actions, *use = NULL;
+	unsigned long start;
+	redir_t *r;
+	int err;
+
+	if (in != STDIN_FILENO || out != STDOUT_FILENO || redirs != NULL)
+	{
+		use = &actions;
+		posix_spawn_file_actions_init(use);
+		if (in != STDIN_FILENO)
+		{
+			posix_spawn_file_actions_adddup2(use, in, 0);
+		}
+		if (out != STDOUT_FILENO)
+		{
+			posix_spawn_file_actions_adddup2(use, out, 1);
+		}
+		for (r = redirs; r != NULL; r = r->next)
+		{
+			posix_spawn_file_actions_adddup2(use, r->source,
+					r->fd);
+		}
+	}
+	start = TRACE_START();
+	err = posix_spawn(pid, full_path, use, NULL, args, env_envp());
+	TRACE_END(TRACE_SPAWN, start);
+	if (use != NULL)
+	{
+		posix_spawn_file_actions_destroy(use);
+	}
+	if (err != 0)
+	{
+		cmd_err(get_shell()->progname, redirs, out, args[0],
+				strerror(err));
+		return (err == ENOENT ? 127 : 126);
+	}
+	return (0);
+}
+
+/**
+ * execute_external_command - Executes an external command and waits
+ * for it to finish.
+ *
+ * When it is the last thing the shell will do, the shell execs it in
+ * place instead, saving a fork and a wait; if that exec fails, the
+ * command is spawned as usual so that the error is reported the same.
+ * @args: An array of command arguments.
+ * @full_path: The full path of the command to execute.
+ * @redirs: The command's redirections, already opened.
+ * Return: The exit status of the command; 127 if it could not be
+ * found and 126 if it could not be executed.
+ */
+int execute_external_command(char **args, const char *full_path,
+		redir_t *redirs)
+{
+	unsigned long start;
+	pid_t pid;
+	int status, err;
+
+	_flush_out();
+	if (get_shell()->exec_tail)
+	{
+		apply_redirs(redirs, 1);
+		execve(full_path, args, env_envp());
+		restore_redirs(redirs);
+	}
+	err = spawn_command(args, full_path, STDIN_FILENO, STDOUT_FILENO,
+			redirs, &pid);
+	if (err != 0)
+	{
+		return (err);
+	}
+	start = TRACE_START();
+	do {
+		waitpid(pid, &status, WUNTRACED);
+	} while (!WIFEXITED(status) && !WIFSIGNALED(status));
+	TRACE_END(TRACE_WAIT, start);
+	return (wait_status(status));
+}
+
+/**
+ * execute_command - Looks up and executes an external command.
+ * @args: An array of command arguments.
+ * @redirs: The command's redirections, already opened.
+ * @progname: The name of the program.
+ * Return: The exit status of the command, or 127 if it was not found.
+ */
+int execute_command(char **args, redir_t *redirs, const char *progname)
+{
+	unsigned long start = TRACE_START();
+	char *full_path = get_full_path(args[0]);
+
+	TRACE_END(TRACE_LOOKUP, start);
+	if (full_path == NULL)
+	{
+		cmd_err(progname, redirs, STDOUT_FILENO, args[0], "not found");
+		return (127);
+	}
+	return (execute_external_command(args, full_path, redirs));
+}
+
+/**
+ * run_builtin - Runs a built-in command in the shell process, with its
+ * redirections applied for the duration of the command only.
+ *
+ * A built-in that returns BUILTIN_EXTERNAL has been given options it
+ * does not implement, and the external command of the same name is run
+ * instead.
+ * @builtin: The built-in command.
+ * @args: Its arguments.
+ * @redirs: Its redirections, already opened.
+ * Return: The exit status of the built-in.
+ */
+int run_builtin(const builtin_t *builtin, char **args, redir_t *redirs)
+{
+	int status;
+
+	if (redirs == NULL)
+	{
+		status = builtin->handler(args);
+	}
+	else
+	{
+		_flush_out();
+		apply_redirs(redirs, 1);
+		status = builtin->handler(args);
+		_flush_out();
+		restore_redirs(redirs);
+	}
+	if (status == BUILTIN_EXTERNAL)
+	{
+		status = execute_command(args, redirs, get_shell()->progname);
+	}
+	return (status);
+}
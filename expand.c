@@ -0,0 +1,153 @@
+#include "shell.h"
+
+static buf_t expand_buf;
+
+/**
+ * parse_var - Recognizes a variable reference ($NAME, ${NAME},
+ * $?, $$ or $!) at the start of a string.
+ * @s: The string.
+ * @name: Where to store a pointer to the variable name.
+ * @name_len: Where to store the length of the name.
+ * Return: The length of the whole reference, or 0 if @s does not
+ * start with one.
+ */
+static size_t parse_var(const char *s, const char **name, size_t *name_len)
+{
+	size_t len = 0;
+	int braced = s[1] == '{';
+
+	if (s[0] != '$')
+	{
+		return (0);
+	}
+	*name = s + 1 + braced;
+	if (!braced && (s[1] == '?' || s[1] == '$' || s[1] == '!'))
+	{
+		*name_len = 1;
+		return (2);
+	}
+	while ((*name)[len] == '_' || my_isalnum((*name)[len]))
+	{
+		len++;
+	}
+	*name_len = len;
+	if (len == 0 || (braced && (*name)[len] != '}'))
+	{
+		return (0);
+	}
+	return (1 + braced + len + braced);
+}
+
+/**
+ * get_env_var_value - Gets the value of a shell variable.
+ * @var_name: The name of the variable (not necessarily NUL-terminated).
+ * @len: The length of the name.
+ * Return: A pointer to the value, or NULL if the variable is not set.
+ */
+char *get_env_var_value(const char *var_name, size_t len)
+{
+	env_var_t *var;
+
+	if (len == 1 && var_name[0] == '?')
+	{
+		return (_itoa(get_shell()->status, arena_alloc(ITOA_SIZE)));
+	}
+	if (len == 1 && var_name[0] == '!')
+	{
+		if (get_shell()->last_bg <= 0)
+		{
+			return (NULL);
+		}
+		return (_itoa(get_shell()->last_bg, arena_alloc(ITOA_SIZE)));
+	}
+	if (len == 1 && var_name[0] == '$')
+	{
+		return (_itoa(getpid(), arena_alloc(ITOA_SIZE)));
+	}
+	var = env_find(var_name, len);
+	return (var != NULL ? var->entry + len + 1 : NULL);
+}
+
+/**
+ * expand_vars - Replaces variable references in a line with their
+ * values in a single pass. Unset variables expand to nothing.
+ * @input: The input line.
+ * Return: The expanded line, valid until the next call.
+ */
+char *expand_vars(const char *input)
+{
+	const char *end = input + _strlen(input), *name, *value;
+	size_t name_len, ref_len, value_len;
+
+	expand_buf.len = 0;
+	buf_reserve(&expand_buf, end - input + 1);
+	while (input < end)
+	{
+		ref_len = parse_var(input, &name, &name_len);
+		if (ref_len == 0)
+		{
+			expand_buf.data[expand_buf.len++] = *input++;
+			continue;
+		}
+		input += ref_len;
+		value = get_env_var_value(name, name_len);
+		value_len = value != NULL ? _strlen(value) : 0;
+		buf_reserve(&expand_buf, expand_buf.len + value_len
+				+ (end - input) + 1);
+		_memcpy(expand_buf.data + expand_buf.len, value, value_len);
+		expand_buf.len += value_len;
+	}
+	expand_buf.data[expand_buf.len] = '\0';
+	return (expand_buf.data);
+}
+
+/**
+ * expand_args - Expands the variable references in a command's
+ * arguments just before it runs, so that each command of a list sees
+ * the status left by the one before it. An argument that contains a
+ * reference is split into fields at blanks after expansion.
+ * @args: The arguments, NULL-terminated.
+ * Return: @args itself if none contains a '$', otherwise a new array
+ * allocated in the command arena.
+ */
+char **expand_args(char **args)
+{
+	static delim_set_t blanks;
+	int size = BUFFER_SIZE, count = 0, i;
+	char **fields, *value;
+	const char *cursor;
+	span_t field;
+
+	for (i = 0; args[i] != NULL && _strchr(args[i], '$') == NULL; i++)
+		;
+	if (args[i] == NULL)
+	{
+		return (args);
+	}
+	if (!blanks.compiled)
+	{
+		delim_compile(&blanks, BLANK_CHARS);
+	}
+	fields = arena_alloc(size * sizeof(char *));
+	for (i = 0; args[i] != NULL; i++)
+	{
+		if (_strchr(args[i], '$') == NULL)
+		{
+			fields = token_push(fields, &count, &size, args[i]);
+			continue;
+		}
+		value = arena_strdup(expand_vars(args[i]));
+		cursor = value;
+		while (next_token(&blanks, &cursor, &field))
+		{
+			fields = token_push(fields, &count, &size,
+					value + (field.start - value));
+			if (*cursor != '\0')
+			{
+				value[cursor++ - value] = '\0';
+			}
+		}
+	}
+	fields[count] = NULL;
+	return (fields);
+}
@@ -1,34 +1,5 @@
 #include "shell.h"
 
-/**
- * _putchar - Writes a character to the standard output.
- * @c: The character to be written.
- */
-void _putchar(char c)
-{
-	write(STDOUT_FILENO, &c, 1);
-}
-
-/**
- * _puts - Writes a string to the standard output followed by a newline.
- * @str: The string to be written.
- * Return: The number of characters written.
- */
-int _puts(const char *str)
-{
-	int characters_written = 0;
-
-	while (*str != '\0')
-	{
-		_putchar(*str);
-		characters_written++;
-		str++;
-	}
-	_putchar('\n');
-	characters_written++;
-	return (characters_written);
-}
-
 /**
  * _atoi - Converts a string to an integer.
  * @str: The string to be converted.
@@ -2,31 +2,32 @@
 
 /**
  * _memmove - Copies a block of memory from source to destination.
+ * The blocks may overlap; bytes are moved a word at a time, each word
+ * being loaded before it is stored.
  * @dest: Pointer to the destination buffer.
  * @src: Pointer to the source buffer.
  * @n: Number of bytes to copy.
  */
 void _memmove(char *dest, const char *src, size_t n)
 {
-	if (dest > src)
+	if (dest < src)
 	{
-		dest += n - 1;
-		src += n - 1;
-		while (n > 0)
-		{
-			*dest = *src;
-			dest--;
-			src--;
-			n--;
-		}
+		_memcpy(dest, src, n);
 	}
-	else if (dest < src)
+	else if (dest > src)
 	{
+		dest += n;
+		src += n;
+		while (n >= sizeof(word_t))
+		{
+			dest -= sizeof(word_t);
+			src -= sizeof(word_t);
+			*(word_t *)dest = *(const word_t *)src;
+			n -= sizeof(word_t);
+		}
 		while (n > 0)
 		{
-			*dest = *src;
-			dest++;
-			src++;
+			*--dest = *--src;
 			n--;
 		}
 	}
@@ -35,41 +36,73 @@ void _memmove(char *dest, const char *src, size_t n)
 /**
  * _itoa - Converts an integer to a string.
  * @num: The integer to be converted.
- * Return: A pointer to the converted string.
+ * @buf: Where to store the string; at least ITOA_SIZE bytes.
+ * Return: @buf.
  */
-char *_itoa(int num)
+char *_itoa(int num, char *buf)
 {
-	static char str[12];
-	int i = 0, j = 0, k = 0, l = 0, m = 0;
+	char digits[ITOA_SIZE];
+	unsigned int n = num < 0 ? 0U - (unsigned int)num : (unsigned int)num;
+	int i = 0, j = 0;
 
-	if (num == 0)
-	{
-		str[0] = '0';
-		str[1] = '\0';
-		return (str);
-	}
+	do {
+		digits[i++] = '0' + n % 10;
+		n /= 10;
+	} while (n != 0);
 	if (num < 0)
 	{
-		l = 1;
-		num = -num;
+		buf[j++] = '-';
 	}
-	m = num;
-	while (m != 0)
+	while (i > 0)
 	{
-		m /= 10;
-		i++;
+		buf[j++] = digits[--i];
 	}
-	j = i - 1 + l;
+	buf[j] = '\0';
+	return (buf);
+}
 
-	if (l == 1)
-		str[0] = '-';
+/**
+ * _memchr - Locates the first occurrence of a byte in a memory block.
+ *
+ * Compares 16 bytes at a time with SSE2, or a word at a time
+ * otherwise, then finishes byte by byte. Loads stay within the block.
+ * @s: The memory block to be searched.
+ * @c: The byte to be located.
+ * @n: The number of bytes to search.
+ * Return: A pointer to the byte, or NULL if not found.
+ */
+char *_memchr(const char *s, int c, size_t n)
+{
+#ifdef __SSE2__
+	__m128i want = _mm_set1_epi8((char)c), v;
+	unsigned int mask;
 
-	for (; j >= l; j--)
+	for (; n >= 16; s += 16, n -= 16)
 	{
-		k = num % 10;
-		str[j] = k + '0';
-		num /= 10;
+		v = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)s), want);
+		mask = (unsigned int)_mm_movemask_epi8(v);
+		if (mask != 0)
+		{
+			return ((char *)s + __builtin_ctz(mask));
+		}
+	}
+#else
+	word_t want = SWAR_ONES * (unsigned char)c;
+
+	for (; n >= sizeof(word_t); s += sizeof(word_t), n -= sizeof(word_t))
+	{
+		if (SWAR_HAS_ZERO(*(const word_t *)s ^ want))
+		{
+			break;
+		}
+	}
+#endif
+	for (; n > 0; s++, n--)
+	{
+		if (*s == (char)c)
+		{
+			return ((char *)s);
+		}
 	}
-	str[i + l] = '\0';
-	return (str);
+	return (NULL);
 }
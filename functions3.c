@@ -2,22 +2,38 @@
 
 /**
  * _strcmp - Compares two strings.
+ *
+ * Compares a word at a time while neither string is within a word of
+ * the end of its page, so the wider loads can never fault.
  * @s1: The first string to compare.
  * @s2: The second string to compare.
  * Return: An integer indicating the comparison result.
  */
-int _strcmp(const char *s1, const char *s2)
+NO_ASAN int _strcmp(const char *s1, const char *s2)
 {
-	while (*s1 != '\0' || *s2 != '\0')
+	const unsigned char *a = (const unsigned char *)s1;
+	const unsigned char *b = (const unsigned char *)s2;
+	word_t w;
+
+	while (1)
 	{
-		if (*s1 != *s2)
+		if (!NEAR_PAGE_END(a) && !NEAR_PAGE_END(b))
+		{
+			w = *(const word_t *)a;
+			if (w == *(const word_t *)b && !SWAR_HAS_ZERO(w))
+			{
+				a += sizeof(word_t);
+				b += sizeof(word_t);
+				continue;
+			}
+		}
+		if (*a != *b || *a == '\0')
 		{
-			return (*s1 - *s2);
+			return (*a - *b);
 		}
-		s1++;
-		s2++;
+		a++;
+		b++;
 	}
-	return (0);
 }
 
 /**
@@ -27,16 +43,32 @@ int _strcmp(const char *s1, const char *s2)
  * @n: The maximum number of characters to compare.
  * Return: An integer indicating the comparison result.
  */
-int _strncmp(const char *s1, const char *s2, size_t n)
+NO_ASAN int _strncmp(const char *s1, const char *s2, size_t n)
 {
-	while (n > 0 && (*s1 != '\0' || *s2 != '\0'))
+	const unsigned char *a = (const unsigned char *)s1;
+	const unsigned char *b = (const unsigned char *)s2;
+	word_t w;
+
+	while (n > 0)
 	{
-		if (*s1 != *s2)
+		if (n >= sizeof(word_t)
+				&& !NEAR_PAGE_END(a) && !NEAR_PAGE_END(b))
+		{
+			w = *(const word_t *)a;
+			if (w == *(const word_t *)b && !SWAR_HAS_ZERO(w))
+			{
+				a += sizeof(word_t);
+				b += sizeof(word_t);
+				n -= sizeof(word_t);
+				continue;
+			}
+		}
+		if (*a != *b || *a == '\0')
 		{
-			return (*s1 - *s2);
+			return (*a - *b);
 		}
-		s1++;
-		s2++;
+		a++;
+		b++;
 		n--;
 	}
 	return (0);
@@ -91,16 +123,53 @@ char *_strcpy(char *dest, const char *src)
 
 /**
  * _strlen - Calculates the length of a string.
+ *
+ * Scans a 64-byte line at a time with SSE2, or a word at a time
+ * otherwise. Loads are aligned, so they never cross into a page the
+ * string does not touch.
  * @str: The string to be measured.
  * Return: The length of the string.
  */
-size_t _strlen(const char *str)
+NO_ASAN size_t _strlen(const char *str)
 {
-	size_t len = 0;
+#ifdef __SSE2__
+	const __m128i *block = (const __m128i *)((size_t)str & ~(size_t)15);
+	__m128i zero = _mm_setzero_si128(), v;
+	unsigned int mask, skip = (size_t)str & 15;
 
-	while (str[len] != '\0')
+	for (;; block++, skip = 0)
+	{
+		if (((size_t)block & 63) == 0)
+		{
+			v = _mm_min_epu8(_mm_min_epu8(block[0], block[1]),
+					_mm_min_epu8(block[2], block[3]));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) == 0)
+			{
+				block += 3;
+				continue;
+			}
+		}
+		v = _mm_cmpeq_epi8(_mm_load_si128(block), zero);
+		mask = (unsigned int)_mm_movemask_epi8(v) & (0xffffu << skip);
+		if (mask != 0)
+		{
+			break;
+		}
+	}
+	return ((const char *)block + __builtin_ctz(mask) - str);
+#else
+	const char *p = str;
+
+	for (; (size_t)p % sizeof(word_t) != 0 && *p != '\0'; p++)
+		;
+	while (*p != '\0' && !SWAR_HAS_ZERO(*(const word_t *)p))
+	{
+		p += sizeof(word_t);
+	}
+	while (*p != '\0')
 	{
-		len++;
+		p++;
 	}
-	return (len);
+	return (p - str);
+#endif
 }
@@ -1,100 +1,67 @@
 #include "shell.h"
 
-/**
- * _strtok - Breaks a string into a sequence of tokens.
- * @str: The string to be tokenized.
- * @delim: The delimiter characters used to tokenize the string.
- * @save_ptr: A pointer to a pointer to save the current position.
- * Return: A pointer to the next token found, or NULL if no more tokens.
- */
-char *_strtok(char *str, const char *delim, char **save_ptr)
-{
-	char *start, *end;
-
-	if (str == NULL)
-	{
-		str = *save_ptr;
-	}
-	start = str;
-	while (*start != '\0' && _strchr(delim, *start) != NULL)
-	{
-		start++;
-	}
-	if (*start == '\0')
-	{
-		*save_ptr = start;
-		return (NULL);
-	}
-	end = start + 1;
-	while (*end != '\0' && _strchr(delim, *end) == NULL)
-	{
-		end++;
-	}
-	if (*end != '\0')
-	{
-		*end = '\0';
-		*save_ptr = end + 1;
-	}
-	else
-	{
-		*save_ptr = end;
-	}
-	return (start);
-}
-
 /**
  * _strchr - Locates the first occurrence of a character in a string.
+ *
+ * Scans 16 bytes at a time with SSE2, or a word at a time otherwise,
+ * looking for either the character or the terminator.
  * @str: The string to be searched.
  * @c: The character to be located.
  * Return: A pointer to the first occurrence of the character,
  * or NULL if not found.
  */
-char *_strchr(const char *str, int c)
+NO_ASAN char *_strchr(const char *str, int c)
 {
-	while (*str != '\0')
+#ifdef __SSE2__
+	const __m128i *block = (const __m128i *)((size_t)str & ~(size_t)15);
+	__m128i zero = _mm_setzero_si128(), want = _mm_set1_epi8((char)c), v;
+	unsigned int mask, skip = (size_t)str & 15;
+
+	for (;; block++, skip = 0)
 	{
-		if (*str == c)
+		v = _mm_load_si128(block);
+		v = _mm_or_si128(_mm_cmpeq_epi8(v, zero),
+				_mm_cmpeq_epi8(v, want));
+		mask = (unsigned int)_mm_movemask_epi8(v);
+		mask &= 0xffffu << skip;
+		if (mask != 0)
 		{
-			return ((char *)str);
+			str = (const char *)block + __builtin_ctz(mask);
+			return (*str == (char)c ? (char *)str : NULL);
 		}
-		str++;
 	}
-	return (NULL);
-}
+#else
+	word_t want = SWAR_ONES * (unsigned char)c, w;
 
-/**
- * my_getchar - Reads a character from standard input.
- * Return: The character read from input,
- * or EOF if end-of-file is reached.
- */
-int my_getchar(void)
-{
-	static char buf[BUFSIZ];
-	static char *bufp = buf;
-	static ssize_t n;
-
-	if (n == 0)
+	for (; (size_t)str % sizeof(word_t) != 0; str++)
 	{
-		n = read(STDIN_FILENO, buf, sizeof(buf));
-		bufp = buf;
+		if (*str == (char)c || *str == '\0')
+		{
+			return (*str == (char)c ? (char *)str : NULL);
+		}
 	}
-	if (n <= 0)
+	w = *(const word_t *)str;
+	while (!SWAR_HAS_ZERO(w) && !SWAR_HAS_ZERO(w ^ want))
 	{
-		return (EOF);
+		str += sizeof(word_t);
+		w = *(const word_t *)str;
+	}
+	while (*str != (char)c && *str != '\0')
+	{
+		str++;
 	}
-	n--;
-	return ((unsigned char) *bufp++);
+	return (*str == (char)c ? (char *)str : NULL);
+#endif
 }
 
 /**
- * my_isalnum - Checks if a character is alphanumeric or '?'.
+ * my_isalnum - Checks if a character is alphanumeric.
  * @c: The character to be checked.
- * Return: 1 if the character is alphanumeric or '?', 0 otherwise.
+ * Return: 1 if the character is alphanumeric, 0 otherwise.
  */
 int my_isalnum(int c)
 {
 	return ((c >= 'A' && c <= 'Z')
 		|| (c >= 'a' && c <= 'z')
-		|| (c >= '0' && c <= '9')
-		|| (c == '?'));
+		|| (c >= '0' && c <= '9'));
 }
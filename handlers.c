@@ -3,97 +3,62 @@
 /**
  * execute_echo - Implements the 'echo' built-in command.
  * @args: Array of command arguments.
+ * Return: Always 0.
  */
-void execute_echo(char **args)
+int execute_echo(char **args)
 {
-	if (args[1] != NULL)
-	{
-		char *output = args[1];
+	int i;
 
-		replace_env_vars(output);
-		_puts(output);
-	}
-	else
+	for (i = 1; args[i] != NULL; i++)
 	{
-		_putchar('\n');
+		if (i > 1)
+		{
+			_putchar(' ');
+		}
+		_write_out(args[i], _strlen(args[i]));
 	}
+	_putchar('\n');
+	return (0);
 }
 
 /**
  * handle_exit - Handles the 'exit' built-in command.
+ * Without an argument the shell exits with the last command's status.
  * @args: Array of command arguments.
+ * Return: Does not return.
  */
-void handle_exit(char **args)
+int handle_exit(char **args)
 {
-	int exit_stat;
+	int exit_stat = get_shell()->status;
 
+	_flush_out();
 	if (args[1] != NULL)
 	{
 		exit_stat = _atoi(args[1]);
-		exit(exit_stat);
-	}
-	else
-	{
-		exit(0);
 	}
+	exit(exit_stat);
 }
 
 /**
- * handle_env - Handles the 'env' built-in command.
+ * handle_env - Handles the 'env' built-in command: prints the
+ * environment. With arguments (assignments, options or a command to
+ * run) it is left to the external env.
+ * @args: Array of command arguments.
+ * Return: 0, or BUILTIN_EXTERNAL if arguments were given.
  */
-void handle_env(void)
+int handle_env(char **args)
 {
-	char **env = environ;
+	char **env = env_envp();
 	int i = 0;
 
+	if (args[1] != NULL)
+	{
+		return (BUILTIN_EXTERNAL);
+	}
 	while (env[i] != NULL)
 	{
 		_puts(env[i]);
 		i++;
 	}
-}
-
-/**
- * read_line - Reads a line of input from the user.
- * Return: A pointer to the input line.
- */
-char *read_line(void)
-{
-	int buffer_size = BUFFER_SIZE;
-	int position = 0;
-	char *buffer = malloc(buffer_size * sizeof(char));
-	int c;
-
-	if (!buffer)
-	{
-		perror("Memory allocation error");
-		exit(EXIT_FAILURE);
-	}
-	while (1)
-	{
-		c = my_getchar();
-
-		if (c == EOF || c == '\n')
-		{
-			if (c == EOF && position == 0)
-			{
-				free(buffer);
-				return (NULL);
-			}
-			buffer[position] = '\0';
-			return (buffer);
-		}
-		buffer[position] = c;
-		position++;
-		if (position >= buffer_size)
-		{
-			buffer_size += BUFFER_SIZE;
-			buffer = _realloc(buffer, buffer_size * sizeof(char));
-			if (!buffer)
-			{
-				perror("Memory allocation error");
-				exit(EXIT_FAILURE);
-			}
-		}
-	}
+	return (0);
 }
@@ -0,0 +1,142 @@
+#include "shell.h"
+
+static hash_entry_t *hash_table[HASH_BUCKETS];
+
+/**
+ * hash_name - Computes the bucket of a command name.
+ * @name: The command name.
+ * Return: The bucket index.
+ */
+static unsigned int hash_name(const char *name)
+{
+	unsigned int h = 5381;
+
+	while (*name != '\0')
+	{
+		h = h * 33 + (unsigned char)*name;
+		name++;
+	}
+	return (h % HASH_BUCKETS);
+}
+
+/**
+ * hash_lookup - Finds a command in the path cache.
+ * @name: The command name.
+ * Return: The cached entry, or NULL if the command is not cached.
+ */
+hash_entry_t *hash_lookup(const char *name)
+{
+	hash_entry_t *entry = hash_table[hash_name(name)];
+
+	while (entry != NULL && _strcmp(entry->name, name) != 0)
+	{
+		entry = entry->next;
+	}
+	return (entry);
+}
+
+/**
+ * hash_insert - Adds a command lookup to the path cache.
+ * @name: The command name.
+ * @path: The full path the command resolved to, or NULL to record
+ * that the command was not found.
+ * Return: The new entry, or NULL on allocation failure.
+ */
+hash_entry_t *hash_insert(const char *name, const char *path)
+{
+	unsigned int bucket = hash_name(name);
+	hash_entry_t *entry = _malloc(sizeof(*entry));
+
+	if (entry == NULL)
+	{
+		return (NULL);
+	}
+	entry->name = _strdup(name);
+	entry->path = path != NULL ? _strdup(path) : NULL;
+	if (entry->name == NULL || (path != NULL && entry->path == NULL))
+	{
+		free(entry->name);
+		free(entry->path);
+		free(entry);
+		return (NULL);
+	}
+	entry->hits = path != NULL;
+	entry->dir_sig = 0;
+	entry->stamp = 0;
+	entry->next = hash_table[bucket];
+	hash_table[bucket] = entry;
+	return (entry);
+}
+
+/**
+ * hash_clear - Forgets every cached command path.
+ * Called whenever PATH changes.
+ */
+void hash_clear(void)
+{
+	hash_entry_t *entry, *next;
+	int i;
+
+	for (i = 0; i < HASH_BUCKETS; i++)
+	{
+		for (entry = hash_table[i]; entry != NULL; entry = next)
+		{
+			next = entry->next;
+			free(entry->name);
+			free(entry->path);
+			free(entry);
+		}
+		hash_table[i] = NULL;
+	}
+}
+
+/**
+ * handle_hash - Handles the 'hash' built-in command.
+ * With no arguments, lists the cached commands; with -r, clears
+ * the cache; otherwise looks up and caches each named command.
+ * @args: Array of command arguments.
+ * Return: 0 on success, 1 if a named command was not found.
+ */
+int handle_hash(char **args)
+{
+	hash_entry_t *entry;
+	char num[ITOA_SIZE];
+	int i, empty = 1, status = 0;
+
+	if (args[1] != NULL && _strcmp(args[1], "-r") == 0)
+	{
+		hash_clear();
+		return (0);
+	}
+	for (i = 1; args[i] != NULL; i++)
+	{
+		if (get_full_path(args[i]) == NULL)
+		{
+			print_err(get_shell()->progname, "not found", args[i]);
+			status = 1;
+		}
+	}
+	for (i = 0; args[1] == NULL && i < HASH_BUCKETS; i++)
+	{
+		for (entry = hash_table[i]; entry != NULL; entry = entry->next)
+		{
+			if (entry->path != NULL)
+			{
+				if (empty)
+				{
+					_puts("hits\tcommand");
+				}
+				empty = 0;
+				_itoa(entry->hits, num);
+				_write_out(num, _strlen(num));
+				_putchar('\t');
+				_puts(entry->path);
+			}
+		}
+	}
+	if (args[1] == NULL && empty)
+	{
+		_puts("hash: hash table empty");
+	}
+	return (status);
+}
@@ -0,0 +1,151 @@
+#include "shell.h"
+
+/**
+ * job_reaped - Records the status of a reaped background process.
+ * @pid: The process ID.
+ * @status: The status reported by waitpid().
+ */
+void job_reaped(pid_t pid, int status)
+{
+	shell_t *shell = get_shell();
+	job_t *job;
+	int i;
+
+	for (job = shell->jobs; job != NULL; job = job->next)
+	{
+		for (i = 0; i < job->count; i++)
+		{
+			if (job->pids[i] != pid)
+			{
+				continue;
+			}
+			job->pids[i] = -1;
+			if (i == job->count - 1)
+			{
+				job->status = wait_status(status);
+			}
+			job->running--;
+			shell->running_jobs -= job->running == 0;
+			return;
+		}
+	}
+}
+
+/**
+ * job_remove - Removes a job from the job table and frees it.
+ * @job: The job.
+ */
+void job_remove(job_t *job)
+{
+	shell_t *shell = get_shell();
+	job_t **link = &shell->jobs;
+
+	while (*link != job)
+	{
+		link = &(*link)->next;
+	}
+	*link = job->next;
+	shell->running_jobs -= job->running > 0;
+	free(job->pids);
+	free(job->command);
+	free(job);
+}
+
+/**
+ * job_print - Prints a job's number, state and command, as 'jobs'
+ * shows it.
+ * @job: The job.
+ */
+void job_print(const job_t *job)
+{
+	char num[ITOA_SIZE];
+
+	_putchar('[');
+	_itoa(job->id, num);
+	_write_out(num, _strlen(num));
+	_write_out("]\t", 2);
+	if (job->running > 0)
+	{
+		_write_out("Running\t", 8);
+	}
+	else if (job->status == 0)
+	{
+		_write_out("Done\t", 5);
+	}
+	else
+	{
+		_write_out("Done(", 5);
+		_itoa(job->status, num);
+		_write_out(num, _strlen(num));
+		_write_out(")\t", 2);
+	}
+	_puts(job->command);
+}
+
+/**
+ * jobs_notify - Reports and forgets the jobs that have finished, before
+ * an interactive prompt.
+ */
+void jobs_notify(void)
+{
+	job_t *job, *next;
+
+	for (job = get_shell()->jobs; job != NULL; job = next)
+	{
+		next = job->next;
+		if (job->running == 0)
+		{
+			job_print(job);
+			job_remove(job);
+		}
+	}
+}
+
+/**
+ * run_background - Starts a pipeline as a background job, with its
+ * standard input taken from /dev/null.
+ * @stage: The first stage.
+ * Return: 0 once the job is started, 1 if nothing could be started.
+ */
+int run_background(cmd_t *stage)
+{
+	shell_t *shell = get_shell();
+	int n = 0, started, *codes, in;
+	char num[ITOA_SIZE];
+	pid_t *pids;
+	job_t *job;
+	cmd_t *s;
+
+	jobs_init();
+	for (s = stage; s != NULL; s = s->next)
+	{
+		n++;
+	}
+	pids = arena_alloc(n * sizeof(*pids));
+	codes = arena_alloc(n * sizeof(*codes));
+	in = open("/dev/null", O_RDONLY | O_CLOEXEC);
+	_flush_out();
+	started = start_pipeline(stage, n, pids, codes,
+			in == -1 ? STDIN_FILENO : in);
+	if (started == 0)
+	{
+		return (1);
+	}
+	if (started < n)
+	{
+		codes[started - 1] = 1;
+	}
+	job = job_add(stage, pids, codes, started);
+	if (job->pid != -1)
+	{
+		shell->last_bg = job->pid;
+	}
+	if (shell->interactive)
+	{
+		_putchar('[');
+		_write_out(num, _strlen(_itoa(job->id, num)));
+		_write_out("] ", 2);
+		_puts(_itoa(job->pid, num));
+	}
+	return (0);
+}
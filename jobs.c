@@ -0,0 +1,163 @@
+#include "shell.h"
+
+static volatile sig_atomic_t chld_pending;
+
+/**
+ * on_sigchld - Notes that a child has changed state. The children are
+ * reaped later, outside the handler, by jobs_reap().
+ * @sig: The signal number (unused).
+ */
+static void on_sigchld(int sig)
+{
+	int saved_errno = errno;
+	ssize_t n;
+
+	(void)sig;
+	chld_pending = 1;
+	n = write(get_shell()->chld_pipe[1], "", 1);
+	(void)n;
+	errno = saved_errno;
+}
+
+/**
+ * jobs_init - Sets up the SIGCHLD self-pipe and handler, the first time
+ * a background job is started.
+ *
+ * The handler writes a byte to the pipe, so that a shell blocked
+ * waiting for input can wake up and reap finished jobs without
+ * polling on a timer. SA_RESTART keeps the signal from interrupting
+ * reads and waits elsewhere.
+ */
+void jobs_init(void)
+{
+	static int ready;
+	shell_t *shell = get_shell();
+	struct sigaction sa;
+
+	if (ready)
+	{
+		return;
+	}
+	ready = 1;
+	if (pipe2(shell->chld_pipe, O_CLOEXEC | O_NONBLOCK) == -1)
+	{
+		shell->chld_pipe[0] = -1;
+		shell->chld_pipe[1] = -1;
+	}
+	sa.sa_handler = on_sigchld;
+	sigemptyset(&sa.sa_mask);
+	sa.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+	sigaction(SIGCHLD, &sa, NULL);
+}
+
+/**
+ * job_text - Builds the command text of a pipeline, for 'jobs'.
+ * @stage: The first stage.
+ * Return: The text, allocated on the heap.
+ */
+static char *job_text(cmd_t *stage)
+{
+	size_t len = 1;
+	char *text, **arg;
+	cmd_t *s;
+
+	for (s = stage; s != NULL; s = s->next)
+	{
+		for (arg = s->args; *arg != NULL; arg++)
+		{
+			len += _strlen(*arg) + 1;
+		}
+		len += 2;
+	}
+	text = _malloc(len);
+	text[0] = '\0';
+	for (s = stage; s != NULL; s = s->next)
+	{
+		for (arg = s->args; *arg != NULL; arg++)
+		{
+			_strcat(text, *arg);
+			if (arg[1] != NULL)
+			{
+				_strcat(text, " ");
+			}
+		}
+		if (s->next != NULL)
+		{
+			_strcat(text, " | ");
+		}
+	}
+	return (text);
+}
+
+/**
+ * job_add - Records a started pipeline in the job table.
+ *
+ * Finished jobs are kept until 'wait' or 'jobs' reports them; past
+ * JOBS_KEEP_DONE of them the oldest is forgotten, so a script that
+ * never waits does not grow the table without bound.
+ * @stage: The first stage, for the command text.
+ * @pids: The process ID of each stage, or -1.
+ * @codes: The status of each stage that was not started.
+ * @count: The number of stages.
+ * Return: The new job.
+ */
+job_t *job_add(cmd_t *stage, pid_t *pids, int *codes, int count)
+{
+	shell_t *shell = get_shell();
+	job_t *job = _malloc(sizeof(*job)), **link, *oldest_done = NULL;
+	int i, done = 0;
+
+	job->pids = _malloc(count * sizeof(*job->pids));
+	job->count = count;
+	job->running = 0;
+	for (i = 0; i < count; i++)
+	{
+		job->pids[i] = pids[i];
+		job->running += pids[i] != -1;
+	}
+	job->pid = pids[count - 1];
+	job->status = codes[count - 1];
+	job->command = job_text(stage);
+	job->next = NULL;
+	job->id = 1;
+	for (link = &shell->jobs; *link != NULL; link = &(*link)->next)
+	{
+		job->id = (*link)->id + 1;
+		done += (*link)->running == 0;
+		if ((*link)->running == 0 && oldest_done == NULL)
+		{
+			oldest_done = *link;
+		}
+	}
+	*link = job;
+	shell->running_jobs += job->running > 0;
+	if (done >= JOBS_KEEP_DONE)
+	{
+		job_remove(oldest_done);
+	}
+	return (job);
+}
+
+/**
+ * jobs_reap - Collects the status of every child that has exited since
+ * the last call. Cheap when nothing has happened: only a flag set by
+ * the SIGCHLD handler is checked.
+ */
+void jobs_reap(void)
+{
+	char drain[64];
+	pid_t pid;
+	int status;
+
+	if (!chld_pending)
+	{
+		return;
+	}
+	chld_pending = 0;
+	while (read(get_shell()->chld_pipe[0], drain, sizeof(drain)) > 0)
+		;
+	while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+	{
+		job_reaped(pid, status);
+	}
+}
@@ -0,0 +1,116 @@
+#include "shell.h"
+
+/**
+ * job_find - Looks up a job by "%number" or by the process ID $!
+ * reported for it.
+ * @spec: The job specification.
+ * Return: The job, or NULL if there is none.
+ */
+static job_t *job_find(const char *spec)
+{
+	job_t *job;
+	char *end;
+	long n = strtol(spec + (spec[0] == '%'), &end, 10);
+
+	if (*end != '\0' || end == spec + (spec[0] == '%'))
+	{
+		return (NULL);
+	}
+	for (job = get_shell()->jobs; job != NULL; job = job->next)
+	{
+		if (spec[0] == '%' ? job->id == n : job->pid == n)
+		{
+			return (job);
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * job_wait - Blocks until every process of a job has exited, then
+ * forgets the job.
+ * @job: The job.
+ * Return: The exit status of the job's last stage.
+ */
+static int job_wait(job_t *job)
+{
+	int i, status;
+	pid_t pid;
+
+	for (i = 0; i < job->count; i++)
+	{
+		pid = job->pids[i];
+		if (pid == -1)
+		{
+			continue;
+		}
+		status = 0;
+		while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+			;
+		job_reaped(pid, status);
+	}
+	status = job->status;
+	job_remove(job);
+	return (status);
+}
+
+/**
+ * handle_wait - Handles the 'wait' built-in command: waits for the
+ * given jobs ("%n" or a process ID), or for all of them.
+ * @args: Array of command arguments.
+ * Return: The status of the last job named, 127 if it is unknown, or
+ * 0 when waiting for all jobs.
+ */
+int handle_wait(char **args)
+{
+	shell_t *shell = get_shell();
+	job_t *job;
+	int i, status = 0;
+
+	_flush_out();
+	jobs_reap();
+	if (args[1] == NULL)
+	{
+		while (shell->jobs != NULL)
+		{
+			job_wait(shell->jobs);
+		}
+		return (0);
+	}
+	for (i = 1; args[i] != NULL; i++)
+	{
+		job = job_find(args[i]);
+		if (job == NULL)
+		{
+			builtin_err("wait", args[i], ": no such job");
+			status = 127;
+			continue;
+		}
+		status = job_wait(job);
+	}
+	return (status);
+}
+
+/**
+ * handle_jobs - Handles the 'jobs' built-in command: lists the
+ * background jobs, then forgets the ones that have finished.
+ * @args: Array of command arguments (unused).
+ * Return: Always 0.
+ */
+int handle_jobs(char **args)
+{
+	job_t *job, *next;
+
+	(void)args;
+	jobs_reap();
+	for (job = get_shell()->jobs; job != NULL; job = next)
+	{
+		next = job->next;
+		job_print(job);
+		if (job->running == 0)
+		{
+			job_remove(job);
+		}
+	}
+	return (0);
+}
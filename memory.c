@@ -8,7 +8,7 @@
 char *_strdup(const char *str)
 {
 	size_t length = _strlen(str);
-	char *new_str = (char *)malloc((length + 1) * sizeof(char));
+	char *new_str = (char *)_malloc((length + 1) * sizeof(char));
 
 	if (new_str != NULL)
 	{
@@ -21,42 +21,49 @@ char *_strdup(const char *str)
 /**
  * _realloc - Reallocates memory for a pointer with a new size.
  * @ptr: Pointer to the memory to be reallocated.
- * @size: The new size of the memory.
+ * @old_size: The number of bytes in use in the old block.
+ * @new_size: The new size of the memory.
  * Return: A pointer to the reallocated memory.
  */
-void *_realloc(void *ptr, size_t size)
+void *_realloc(void *ptr, size_t old_size, size_t new_size)
 {
-	size_t old_size, copy_size;
 	void *new_ptr;
 
 	if (ptr == NULL)
 	{
-		return (malloc(size));
+		return (_malloc(new_size));
 	}
-	if (size == 0)
+	if (new_size == 0)
 	{
 		free(ptr);
 		return (NULL);
 	}
-	new_ptr = malloc(size);
+	new_ptr = _malloc(new_size);
 	if (new_ptr != NULL)
 	{
-		old_size = _strlen((const char *)ptr);
-		copy_size = old_size < size ? old_size : size;
-		_strncpy((char *)new_ptr, (const char *)ptr, copy_size);
+		_memcpy(new_ptr, ptr,
+				old_size < new_size ? old_size : new_size);
 		free(ptr);
 	}
 	return (new_ptr);
 }
 
 /**
- * _memcpy - Copies memory from source to destination.
+ * _memcpy - Copies memory from source to destination,
+ * a word at a time.
  * @dest: Destination memory.
  * @src: Source memory.
  * @n: Number of bytes to copy.
  */
 void _memcpy(char *dest, const char *src, size_t n)
 {
+	while (n >= sizeof(word_t))
+	{
+		*(word_t *)dest = *(const word_t *)src;
+		dest += sizeof(word_t);
+		src += sizeof(word_t);
+		n -= sizeof(word_t);
+	}
 	while (n > 0)
 	{
 		*dest = *src;
@@ -67,13 +74,26 @@ void _memcpy(char *dest, const char *src, size_t n)
 }
 
 /**
- * free_memory - Frees memory allocated for
- * input and arguments.
- * @input: Input string memory.
- * @args: Array of argument strings.
+ * _malloc - Allocates memory, counting the allocation.
+ * @size: The number of bytes to allocate.
+ * Return: A pointer to the memory, or NULL on failure.
+ */
+void *_malloc(size_t size)
+{
+	alloc_count(1);
+	return (malloc(size));
+}
+
+/**
+ * alloc_count - Counts heap allocations made by the shell.
+ * Set HSH_ALLOC_STATS to have the total reported at exit.
+ * @add: The number of allocations to add.
+ * Return: The number of allocations so far.
  */
-void free_memory(char *input, char **args)
+unsigned long alloc_count(int add)
 {
-	free(input);
-	free(args);
+	static unsigned long count;
+
+	count += add;
+	return (count);
 }
@@ -0,0 +1,65 @@
+#include "shell.h"
+
+/*
+ * The operators, longest first wherever one is a prefix of another.
+ * split_input() stores pointers to these very strings, so an operator
+ * token is recognized by its address.
+ */
+static const operator_t operators[] = {
+	{"&&", LIST_AND, -1},
+	{"&", LIST_BG, -1},
+	{"||", LIST_OR, -1},
+	{"|", LIST_PIPE, -1},
+	{";", LIST_SEQ, -1},
+	{"2>&1", REDIR_DUP, STDERR_FILENO},
+	{"2>>", REDIR_APPEND, STDERR_FILENO},
+	{"2>", REDIR_OUT, STDERR_FILENO},
+	{">>", REDIR_APPEND, STDOUT_FILENO},
+	{">", REDIR_OUT, STDOUT_FILENO},
+	{"<", REDIR_IN, STDIN_FILENO}
+};
+
+/**
+ * lex_operator - Recognizes an operator at the start of a string.
+ * @p: The string.
+ * Return: The operator's canonical string, or NULL if @p does not
+ * start with one.
+ */
+const char *lex_operator(const char *p)
+{
+	size_t i;
+
+	if (*p == '\0' || (_strchr(OPERATOR_CHARS, *p) == NULL
+				&& (p[0] != '2' || p[1] != '>')))
+	{
+		return (NULL);
+	}
+	for (i = 0; i < sizeof(operators) / sizeof(operators[0]); i++)
+	{
+		if (_strncmp(p, operators[i].text,
+					_strlen(operators[i].text)) == 0)
+		{
+			return (operators[i].text);
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * find_operator - Looks up the operator a token stands for.
+ * @token: The token.
+ * Return: The operator, or NULL if @token is a word.
+ */
+const operator_t *find_operator(const char *token)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(operators) / sizeof(operators[0]); i++)
+	{
+		if (token == operators[i].text)
+		{
+			return (&operators[i]);
+		}
+	}
+	return (NULL);
+}
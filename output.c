@@ -0,0 +1,94 @@
+#include "shell.h"
+
+static out_t out;
+
+/**
+ * get_out - Returns the output buffer, for the functions that drain it
+ * in other ways.
+ * Return: A pointer to the buffer.
+ */
+out_t *get_out(void)
+{
+	return (&out);
+}
+
+/**
+ * _flush_out - Writes any buffered output to the standard output.
+ * Must be called before forking or exiting so output stays ordered.
+ */
+void _flush_out(void)
+{
+	size_t done = 0;
+	ssize_t n;
+
+	while (done < out.len)
+	{
+		n = write(STDOUT_FILENO, out.buf + done, out.len - done);
+		if (n <= 0)
+		{
+			break;
+		}
+		done += n;
+	}
+	out.len = 0;
+}
+
+/**
+ * _write_out - Appends a block of bytes to the output buffer.
+ * @s: The bytes to be written.
+ * @n: The number of bytes.
+ */
+void _write_out(const char *s, size_t n)
+{
+	size_t chunk;
+	int has_newline = out.line_mode && _memchr(s, '\n', n) != NULL;
+
+	while (n > 0)
+	{
+		if (out.len == sizeof(out.buf))
+		{
+			_flush_out();
+		}
+		chunk = sizeof(out.buf) - out.len;
+		chunk = chunk < n ? chunk : n;
+		_memcpy(out.buf + out.len, s, chunk);
+		out.len += chunk;
+		s += chunk;
+		n -= chunk;
+	}
+	if (has_newline)
+	{
+		_flush_out();
+	}
+}
+
+/**
+ * _putchar - Writes a character to the standard output.
+ * @c: The character to be written.
+ */
+void _putchar(char c)
+{
+	if (out.len == sizeof(out.buf))
+	{
+		_flush_out();
+	}
+	out.buf[out.len++] = c;
+	if (out.line_mode && c == '\n')
+	{
+		_flush_out();
+	}
+}
+
+/**
+ * _puts - Writes a string to the standard output followed by a newline.
+ * @str: The string to be written.
+ * Return: The number of characters written.
+ */
+int _puts(const char *str)
+{
+	size_t len = _strlen(str);
+
+	_write_out(str, len);
+	_putchar('\n');
+	return (len + 1);
+}
@@ -0,0 +1,44 @@
+#include "shell.h"
+
+/**
+ * set_out_mode - Selects when buffered output is flushed.
+ * @line_buffered: Non-zero to flush at every newline (interactive
+ * mode), zero to flush only when the buffer is full (batch mode).
+ */
+void set_out_mode(int line_buffered)
+{
+	get_out()->line_mode = line_buffered;
+}
+
+/**
+ * _splice_out - Hands any buffered output to the standard output
+ * with vmsplice(), which maps the buffer's pages into a pipe instead
+ * of copying them. The pipe keeps referring to the pages until they
+ * are read, so this is only safe as the last output of a process
+ * that is about to exit. If standard output is not a pipe the bytes
+ * are written normally.
+ */
+void _splice_out(void)
+{
+	out_t *out = get_out();
+	struct iovec iov;
+	ssize_t n;
+
+	iov.iov_base = out->buf;
+	iov.iov_len = out->len;
+	while (iov.iov_len > 0)
+	{
+		n = vmsplice(STDOUT_FILENO, &iov, 1, 0);
+		if (n <= 0)
+		{
+			n = write(STDOUT_FILENO, iov.iov_base, iov.iov_len);
+		}
+		if (n <= 0)
+		{
+			break;
+		}
+		iov.iov_base = (char *)iov.iov_base + n;
+		iov.iov_len -= n;
+	}
+	out->len = 0;
+}
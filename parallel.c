@@ -0,0 +1,115 @@
+#include "shell.h"
+
+/**
+ * parallel_options - Parses the options of the 'parallel' built-in.
+ * @args: Array of command arguments.
+ * @pl: The built-in's state; its slots and item limit are filled in.
+ * Return: The index of the command, or -1 after a usage error.
+ */
+static int parallel_options(char **args, parallel_t *pl)
+{
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	int i;
+
+	pl->slots = cpus > 0 ? cpus : 1;
+	for (i = 1; args[i] && args[i][0] == '-' && args[i + 1]; i += 2)
+	{
+		if (_strcmp(args[i], "-P") == 0 && _atoi(args[i + 1]) > 0)
+		{
+			pl->slots = _atoi(args[i + 1]);
+		}
+		else if (_strcmp(args[i], "-n") == 0 && _atoi(args[i + 1]) > 0)
+		{
+			pl->max_items = _atoi(args[i + 1]);
+		}
+		else
+		{
+			break;
+		}
+	}
+	if (args[i] == NULL || args[i][0] == '-')
+	{
+		builtin_err("parallel", "usage: parallel [-P jobs] [-n items]",
+				" command [arg...]");
+		return (-1);
+	}
+	return (i);
+}
+
+/**
+ * parallel_setup - Sizes the execs and allocates the argument vector
+ * and the worker slots.
+ *
+ * Each item takes at least two bytes and a pointer of the exec size,
+ * which bounds the items one exec can carry; the vector holds the
+ * command words, that many items and the terminating NULL.
+ * @pl: The built-in's state.
+ * @command: The command and its arguments.
+ */
+static void parallel_setup(parallel_t *pl, char **command)
+{
+	char **env = env_envp();
+	long limit = sysconf(_SC_ARG_MAX) - PARALLEL_HEADROOM;
+	size_t items;
+	int i;
+
+	for (; *env != NULL; env++)
+	{
+		limit -= _strlen(*env) + 1 + sizeof(char *);
+	}
+	for (pl->nargs = 0; command[pl->nargs] != NULL; pl->nargs++)
+	{
+		pl->fixed_bytes += _strlen(command[pl->nargs]) + 1
+			+ sizeof(char *);
+	}
+	limit = limit < 0 ? 0 : limit;
+	pl->limit = limit < PARALLEL_MAX_BYTES ? limit : PARALLEL_MAX_BYTES;
+	pl->bytes = pl->fixed_bytes;
+	items = pl->limit / (sizeof(char *) + 2) + 1;
+	if (pl->max_items > 0 && (size_t)pl->max_items < items)
+	{
+		items = pl->max_items;
+	}
+	pl->argv = arena_alloc((pl->nargs + items + 1) * sizeof(char *));
+	_memcpy((char *)pl->argv, (char *)command, pl->nargs * sizeof(char *));
+	pl->pids = arena_alloc(pl->slots * sizeof(pid_t));
+	for (i = 0; i < pl->slots; i++)
+	{
+		pl->pids[i] = -1;
+	}
+}
+
+/**
+ * handle_parallel - Handles the 'parallel' built-in command: runs a
+ * command over the blank-separated items read from the standard
+ * input, like xargs -P. The command is resolved once, several items
+ * go to each exec (within -n and the exec size limit), and up to -P
+ * workers run at a time.
+ * @args: Array of command arguments.
+ * Return: 0 if every worker succeeded, 123 if one failed, 125 if one
+ * was killed, 126 or 127 if the command could not be run, 2 on a
+ * usage error.
+ */
+int handle_parallel(char **args)
+{
+	parallel_t pl = {0};
+	int i = parallel_options(args, &pl);
+
+	if (i == -1)
+	{
+		return (2);
+	}
+	pl.path = get_full_path(args[i]);
+	if (pl.path == NULL)
+	{
+		builtin_err("parallel", args[i], ": not found");
+		return (127);
+	}
+	parallel_setup(&pl, args + i);
+	pl.null_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+	_flush_out();
+	parallel_run(&pl);
+	close(pl.null_fd);
+	free(pl.text.data);
+	return (pl.status);
+}
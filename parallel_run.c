@@ -0,0 +1,191 @@
+#include "shell.h"
+
+/**
+ * parallel_wait - Blocks until one of the workers exits. A background
+ * job reaped in passing is handed to the job table.
+ * @pl: The built-in's state.
+ */
+static void parallel_wait(parallel_t *pl)
+{
+	pid_t pid;
+	int status, i;
+
+	while ((pid = waitpid(-1, &status, 0)) != -1 || errno == EINTR)
+	{
+		for (i = 0; pid != -1 && i < pl->slots; i++)
+		{
+			if (pl->pids[i] != pid)
+			{
+				continue;
+			}
+			pl->pids[i] = -1;
+			pl->running--;
+			if (WIFSIGNALED(status) && pl->status < PARALLEL_STOP)
+			{
+				pl->status = 125;
+			}
+			else if (WEXITSTATUS(status) != 0 && pl->status == 0)
+			{
+				pl->status = 123;
+			}
+			return;
+		}
+		if (pid != -1)
+		{
+			job_reaped(pid, status);
+		}
+	}
+	pl->running = 0;
+}
+
+/**
+ * parallel_spawn - Starts a worker on the first pending items, waiting
+ * for a free slot if all are busy, and drops those items. Nothing is
+ * started once the command has failed to run.
+ *
+ * posix_spawn() has copied the argument vector by the time it returns,
+ * so the items can be moved down at once.
+ * @pl: The built-in's state.
+ * @count: The number of items to pass.
+ */
+static void parallel_spawn(parallel_t *pl, int count)
+{
+	char *item = pl->text.data;
+	int i, slot, err;
+
+	if (pl->status >= PARALLEL_STOP)
+	{
+		return;
+	}
+	for (i = 0; i < count; i++, item += _strlen(item) + 1)
+	{
+		pl->argv[pl->nargs + i] = item;
+	}
+	pl->argv[pl->nargs + count] = NULL;
+	if (pl->running == pl->slots)
+	{
+		parallel_wait(pl);
+	}
+	for (slot = 0; pl->pids[slot] != -1; slot++)
+		;
+	err = spawn_command(pl->argv, pl->path, pl->null_fd, STDOUT_FILENO,
+			NULL, &pl->pids[slot]);
+	if (err != 0)
+	{
+		pl->status = err;
+		return;
+	}
+	pl->running++;
+	pl->text.len -= item - pl->text.data;
+	_memmove(pl->text.data, item, pl->text.len);
+	pl->count -= count;
+	pl->bytes = pl->fixed_bytes;
+	for (i = 0, item = pl->text.data; i < pl->count; i++)
+	{
+		pl->bytes += _strlen(item) + 1 + sizeof(char *);
+		item += _strlen(item) + 1;
+	}
+}
+
+/**
+ * parallel_end_item - Completes the item being read, and starts a
+ * worker once the pending items fill an exec: @max_items of them, or
+ * as many as fit under the byte limit.
+ * @pl: The built-in's state.
+ * @len: The length of the item.
+ */
+static void parallel_end_item(parallel_t *pl, size_t len)
+{
+	buf_append(&pl->text, "", 1);
+	pl->count++;
+	pl->bytes += len + 1 + sizeof(char *);
+	if (pl->bytes > pl->limit && pl->count > 1)
+	{
+		parallel_spawn(pl, pl->count - 1);
+	}
+	if (pl->count == pl->max_items || pl->bytes > pl->limit)
+	{
+		parallel_spawn(pl, pl->count);
+	}
+}
+
+/**
+ * parallel_scan - Splits a block of input into items, completing each
+ * item that ends in the block.
+ * @pl: The built-in's state.
+ * @p: The block, NUL-terminated.
+ * @end: The end of the block.
+ * @len: The length of the item read so far, from earlier blocks.
+ * Return: The length of the item still being read at @end.
+ */
+static size_t parallel_scan(parallel_t *pl, const char *p, const char *end,
+		size_t len)
+{
+	static delim_set_t blanks;
+	const char *stop;
+
+	if (!blanks.compiled)
+	{
+		delim_compile(&blanks, " \t\n");
+	}
+	for (; p < end; p = stop + 1)
+	{
+		stop = scan_delim(&blanks, p);
+		if (stop > p)
+		{
+			buf_append(&pl->text, p, stop - p);
+		}
+		len += stop - p;
+		if (stop == end)
+		{
+			break;
+		}
+		if (len > 0)
+		{
+			parallel_end_item(pl, len);
+		}
+		len = 0;
+	}
+	return (len);
+}
+
+/**
+ * parallel_run - Reads blank-separated items from the standard input,
+ * fans them out over the workers as they fill execs, and waits for
+ * the last workers. Reading stops as soon as the command cannot be
+ * run, as with xargs.
+ * @pl: The built-in's state.
+ */
+void parallel_run(parallel_t *pl)
+{
+	char block[BUFSIZ + 1];
+	size_t len = 0;
+	ssize_t n;
+
+	while (pl->status < PARALLEL_STOP
+			&& (n = read(STDIN_FILENO, block, BUFSIZ)) != 0)
+	{
+		if (n == -1 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n == -1)
+		{
+			break;
+		}
+		block[n] = '\0';
+		len = parallel_scan(pl, block, block + n, len);
+	}
+	if (len > 0)
+	{
+		parallel_end_item(pl, len);
+	}
+	if (pl->count > 0)
+	{
+		parallel_spawn(pl, pl->count);
+	}
+	while (pl->running > 0)
+	{
+		parallel_wait(pl);
+	}
+}
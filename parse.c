@@ -0,0 +1,151 @@
+#include "shell.h"
+
+/**
+ * syntax_error - Reports an unexpected token.
+ * @token: The token, or NULL for the end of the line.
+ * Return: Always 2, the status of a syntax error.
+ */
+static int syntax_error(const char *token)
+{
+	const char *parts[7];
+	char line[ITOA_SIZE];
+	int n = err_prefix(parts, get_shell()->progname, line);
+
+	parts[n++] = token != NULL ? "Syntax error: \"" : "Syntax error: ";
+	parts[n++] = token != NULL ? token : "end of file";
+	parts[n++] = token != NULL ? "\" unexpected\n" : " unexpected\n";
+	write_err(parts, n);
+	return (2);
+}
+
+/**
+ * parse_redir - Parses a redirection and appends it to a command's.
+ * @tokens: The redirection operator's token, followed by its target.
+ * @op: The operator.
+ * @link: Where to link the redirection; advanced to its next field.
+ * Return: The number of tokens taken after the operator (1 for the
+ * target, 0 for 2>&1), or -1 on a syntax error.
+ */
+static int parse_redir(char **tokens, const operator_t *op, redir_t ***link)
+{
+	redir_t *redir = arena_alloc(sizeof(*redir));
+
+	redir->fd = op->fd;
+	redir->kind = op->kind;
+	redir->target = NULL;
+	redir->next = NULL;
+	**link = redir;
+	*link = &redir->next;
+	if (op->kind == REDIR_DUP)
+	{
+		return (0);
+	}
+	if (tokens[1] == NULL || find_operator(tokens[1]) != NULL)
+	{
+		syntax_error(tokens[1]);
+		return (-1);
+	}
+	redir->target = tokens[1];
+	return (1);
+}
+
+/**
+ * parse_command - Parses one simple command: its words and its
+ * redirections, up to the next control operator.
+ *
+ * The words are moved down over the redirection tokens, so the
+ * argument vector stays in place in the token array.
+ * @cursor: The first token of the command; advanced past the control
+ * operator that ends it.
+ * @cmd: The command to fill in.
+ * Return: The kind of that operator (LIST_SEQ at the end of the
+ * line), or -1 on a syntax error.
+ */
+static int parse_command(char ***cursor, cmd_t *cmd)
+{
+	char **tokens = *cursor, **out = tokens;
+	const operator_t *op = NULL;
+	redir_t **link = &cmd->redirs;
+	int kind, n;
+
+	cmd->args = tokens;
+	cmd->redirs = NULL;
+	cmd->next = NULL;
+	for (; *tokens != NULL; tokens++)
+	{
+		op = find_operator(*tokens);
+		if (op == NULL)
+		{
+			*out++ = *tokens;
+			continue;
+		}
+		if (op->kind < REDIR_IN)
+		{
+			break;
+		}
+		n = parse_redir(tokens, op, &link);
+		if (n == -1)
+		{
+			return (-1);
+		}
+		tokens += n;
+	}
+	if (out == cmd->args && cmd->redirs == NULL)
+	{
+		syntax_error(*tokens);
+		return (-1);
+	}
+	kind = *tokens != NULL ? op->kind : LIST_SEQ;
+	*cursor = *tokens != NULL ? tokens + 1 : tokens;
+	*out = NULL;
+	return (kind);
+}
+
+/**
+ * parse_list - Builds the command list of a line from its tokens.
+ *
+ * Each element of the list is a pipeline of one or more commands,
+ * run in the background if it is followed by '&'.
+ * The argument vectors are carved out of @tokens in place: each
+ * operator is replaced by the NULL that ends the command before it.
+ * @tokens: The tokens of the line, as returned by split_input().
+ * @list: Where to store the first element, or NULL for an empty line.
+ * Return: 0 on success, 2 on a syntax error.
+ */
+int parse_list(char **tokens, list_node_t **list)
+{
+	list_node_t *node, **link = list;
+	cmd_t **stage;
+	int op = LIST_SEQ;
+
+	*list = NULL;
+	while (*tokens != NULL)
+	{
+		node = arena_alloc(sizeof(*node));
+		node->op = op;
+		node->background = 0;
+		node->next = NULL;
+		*link = node;
+		link = &node->next;
+		stage = &node->pipeline;
+		do {
+			*stage = arena_alloc(sizeof(**stage));
+			op = parse_command(&tokens, *stage);
+			if (op == -1)
+			{
+				return (2);
+			}
+			stage = &(*stage)->next;
+		} while (op == LIST_PIPE);
+		node->background = op == LIST_BG;
+		if (op == LIST_BG)
+		{
+			op = LIST_SEQ;
+		}
+		if (*tokens == NULL && op != LIST_SEQ)
+		{
+			return (syntax_error(NULL));
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,152 @@
+#include "shell.h"
+
+/**
+ * join_path - Builds the full path of a command in a directory.
+ * @dir: The directory.
+ * @command: The command name.
+ * Return: A pointer to the full path, allocated in the command arena.
+ */
+static char *join_path(const char *dir, const char *command)
+{
+	char *full_path = arena_alloc(_strlen(dir) + _strlen(command) + 2);
+
+	_strcpy(full_path, dir);
+	_strcat(full_path, "/");
+	_strcat(full_path, command);
+	return (full_path);
+}
+
+/**
+ * search_path - Looks for a command in the PATH directories, probing
+ * each one relative to its cached descriptor. The full path string
+ * is only built for the directory that holds the command.
+ * @command: The command to look for.
+ * Return: A pointer to the full path string, or NULL if not found.
+ */
+static char *search_path(const char *command)
+{
+	char *full_path;
+	path_dir_t *dirs;
+	int count, i;
+
+	dirs = get_path_dirs(&count);
+	for (i = 0; i < count; i++)
+	{
+		if (dirs[i].fd != -1)
+		{
+			if (faccessat(dirs[i].fd, command, X_OK, 0) == 0)
+			{
+				return (join_path(dirs[i].name, command));
+			}
+			continue;
+		}
+		full_path = join_path(dirs[i].name, command);
+		if (access(full_path, X_OK) == 0)
+		{
+			return (full_path);
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * path_dirs_sig - Computes a signature of the files named @command in
+ * the PATH directories. Creating, removing or renaming such a file
+ * changes the signature, and so does a chmod, which changes its ctime.
+ * One fstatat() per directory, the cost of the access() calls a plain
+ * search makes.
+ * @command: The command looked for.
+ * Return: The signature.
+ */
+static unsigned long path_dirs_sig(const char *command)
+{
+	path_dir_t *dirs;
+	unsigned long sig = 0;
+	struct stat st;
+	int count, i, err;
+
+	dirs = get_path_dirs(&count);
+	for (i = 0; i < count; i++)
+	{
+		sig *= 31;
+		err = dirs[i].fd != -1 ? fstatat(dirs[i].fd, command, &st, 0)
+			: stat(join_path(dirs[i].name, command), &st);
+		if (err == 0)
+		{
+			sig += st.st_ino ^ st.st_ctime ^ st.st_ctim.tv_nsec;
+		}
+	}
+	return (sig);
+}
+
+/**
+ * neg_cache_fresh - Checks whether a cached miss still holds.
+ *
+ * Within HSH_NEGCACHE_TTL seconds of the last check the miss is
+ * trusted outright; after that it holds as long as no file of that
+ * name in a PATH directory has appeared, gone or changed.
+ * @entry: The negative cache entry.
+ * @command: The command it is for.
+ * Return: 1 if the command is still known to be missing, 0 otherwise.
+ */
+static int neg_cache_fresh(hash_entry_t *entry, const char *command)
+{
+	char *ttl_env = _getenv("HSH_NEGCACHE_TTL");
+	time_t now = time(NULL);
+
+	if (ttl_env != NULL && now - entry->stamp < _atoi(ttl_env))
+	{
+		return (1);
+	}
+	if (path_dirs_sig(command) != entry->dir_sig)
+	{
+		return (0);
+	}
+	entry->stamp = now;
+	return (1);
+}
+
+/**
+ * get_full_path - Returns the full path of a command.
+ * @command: The command to find the full path for.
+ * Return: A pointer to the full path string, allocated in the command
+ * arena, or NULL if not found.
+ */
+char *get_full_path(const char *command)
+{
+	hash_entry_t *cached;
+	unsigned long sig;
+	char *full_path;
+
+	if (_strchr(command, '/') != NULL)
+	{
+		return (arena_strdup(command));
+	}
+	cached = hash_lookup(command);
+	if (cached != NULL && cached->path != NULL)
+	{
+		cached->hits++;
+		return (arena_strdup(cached->path));
+	}
+	if (cached != NULL && neg_cache_fresh(cached, command))
+	{
+		return (NULL);
+	}
+	sig = path_dirs_sig(command);
+	full_path = search_path(command);
+	if (cached == NULL)
+	{
+		cached = hash_insert(command, full_path);
+	}
+	else if (full_path != NULL)
+	{
+		cached->path = _strdup(full_path);
+		cached->hits = 1;
+	}
+	if (cached != NULL && full_path == NULL)
+	{
+		cached->dir_sig = sig;
+		cached->stamp = time(NULL);
+	}
+	return (full_path);
+}
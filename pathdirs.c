@@ -0,0 +1,78 @@
+#include "shell.h"
+
+static buf_t path_dirs_buf;
+static int path_dirs_count;
+static int path_dirs_loaded;
+
+/**
+ * path_changed - Drops everything cached about PATH.
+ * Called by _setenv() and _unsetenv() whenever PATH is modified.
+ */
+void path_changed(void)
+{
+	path_dir_t *dirs = (path_dir_t *)path_dirs_buf.data;
+	int i;
+
+	hash_clear();
+	for (i = 0; i < path_dirs_count; i++)
+	{
+		if (dirs[i].fd != -1)
+		{
+			close(dirs[i].fd);
+		}
+		free(dirs[i].name);
+	}
+	path_dirs_buf.len = 0;
+	path_dirs_count = 0;
+	path_dirs_loaded = 0;
+}
+
+/**
+ * load_path_dirs - Opens every PATH directory once as an O_PATH
+ * descriptor. Relative entries keep no descriptor, since they must
+ * follow the current directory.
+ */
+static void load_path_dirs(void)
+{
+	static delim_set_t colon;
+	const char *cursor = _getenv("PATH");
+	span_t token;
+	path_dir_t dir;
+
+	path_dirs_loaded = 1;
+	if (!colon.compiled)
+	{
+		delim_compile(&colon, ":");
+	}
+	while (cursor != NULL && next_token(&colon, &cursor, &token))
+	{
+		dir.name = _malloc(token.len + 1);
+		if (dir.name == NULL)
+		{
+			perror("Memory allocation error");
+			exit(EXIT_FAILURE);
+		}
+		_memcpy(dir.name, token.start, token.len);
+		dir.name[token.len] = '\0';
+		dir.fd = dir.name[0] != '/' ? -1 :
+			open(dir.name, O_PATH | O_DIRECTORY | O_CLOEXEC);
+		buf_append(&path_dirs_buf, (char *)&dir, sizeof(dir));
+		path_dirs_count++;
+	}
+}
+
+/**
+ * get_path_dirs - Returns the PATH directory index, building it
+ * on first use after PATH changed.
+ * @count: Where to store the number of directories.
+ * Return: The array of directories.
+ */
+path_dir_t *get_path_dirs(int *count)
+{
+	if (!path_dirs_loaded)
+	{
+		load_path_dirs();
+	}
+	*count = path_dirs_count;
+	return ((path_dir_t *)path_dirs_buf.data);
+}
@@ -0,0 +1,227 @@
+#include "shell.h"
+
+/**
+ * fork_builtin - Runs a built-in command as a pipeline stage in a
+ * child process, so that it runs concurrently with the other stages.
+ * @builtin: The built-in command.
+ * @args: Its arguments.
+ * @redirs: Its redirections, already opened.
+ * @in: The descriptor to use as its standard input.
+ * @out: The descriptor to use as its standard output.
+ * @spare: The read end of its own output pipe, which the child must
+ * close so that a reader exiting early is noticed, or -1.
+ * Return: The child's process ID, or -1 if fork() failed, which is
+ * reported.
+ */
+static pid_t fork_builtin(const builtin_t *builtin, char **args,
+		redir_t *redirs, int in, int out, int spare)
+{
+	pid_t pid = fork();
+	int status;
+
+	if (pid != 0)
+	{
+		if (pid == -1)
+		{
+			perror("fork");
+		}
+		return (pid);
+	}
+	if (spare != -1)
+	{
+		close(spare);
+	}
+	if (in != STDIN_FILENO)
+	{
+		dup2(in, STDIN_FILENO);
+	}
+	if (out != STDOUT_FILENO)
+	{
+		dup2(out, STDOUT_FILENO);
+	}
+	apply_redirs(redirs, 0);
+	set_out_mode(0);
+	status = builtin->handler(args);
+	if (status == BUILTIN_EXTERNAL)
+	{
+		status = execute_command(args, NULL, get_shell()->progname);
+	}
+	_splice_out();
+	_exit(status);
+}
+
+/**
+ * start_stage - Starts one stage of a pipeline without waiting for it.
+ * @cmd: The stage.
+ * @in: The descriptor to use as its standard input.
+ * @out: The descriptor to use as its standard output.
+ * @spare: The read end of its own output pipe, or -1.
+ * @code: Where to store the stage's status if it could not be started
+ * (or was empty); set to 0 otherwise.
+ * Return: The process ID of the stage, or -1 if none was started.
+ */
+static pid_t start_stage(cmd_t *cmd, int in, int out, int spare, int *code)
+{
+	const builtin_t *builtin;
+	unsigned long start = TRACE_START();
+	char **args = expand_args(cmd->args), *full_path;
+	pid_t pid = -1;
+
+	TRACE_END(TRACE_EXPAND, start);
+	start = TRACE_START();
+	*code = open_redirs(cmd->redirs);
+	if (*code != 0 || args[0] == NULL)
+	{
+		close_redirs(cmd->redirs);
+		return (-1);
+	}
+	builtin = find_builtin(args[0]);
+	TRACE_END(TRACE_DISPATCH, start);
+	if (builtin != NULL)
+	{
+		pid = fork_builtin(builtin, args, cmd->redirs, in, out, spare);
+		*code = pid == -1 ? 1 : 0;
+	}
+	else
+	{
+		start = TRACE_START();
+		full_path = get_full_path(args[0]);
+		TRACE_END(TRACE_LOOKUP, start);
+		if (full_path == NULL)
+		{
+			cmd_err(get_shell()->progname, cmd->redirs, out,
+					args[0], "not found");
+			*code = 127;
+		}
+		else
+		{
+			*code = spawn_command(args, full_path, in, out,
+					cmd->redirs, &pid);
+		}
+	}
+	close_redirs(cmd->redirs);
+	return (*code == 0 ? pid : -1);
+}
+
+/**
+ * start_pipeline - Starts the stages of a pipeline, each connected to
+ * the next by a pipe, without waiting for any of them.
+ *
+ * The pipes are created close-on-exec, so each external stage keeps
+ * only the two ends it was given.
+ * @stage: The first stage.
+ * @n: The number of stages.
+ * @pids: Where to store the process ID of each stage, or -1.
+ * @codes: Where to store the status of each stage that was not started.
+ * @in: The standard input of the first stage; closed here unless it
+ * is STDIN_FILENO.
+ * Return: The number of stages started, less than @n if a pipe could
+ * not be created.
+ */
+int start_pipeline(cmd_t *stage, int n, pid_t *pids, int *codes, int in)
+{
+	int fds[2], started;
+
+	for (started = 0; started < n; started++, stage = stage->next)
+	{
+		fds[0] = -1;
+		fds[1] = STDOUT_FILENO;
+		if (stage->next != NULL && pipe2(fds, O_CLOEXEC) == -1)
+		{
+			perror("pipe");
+			break;
+		}
+		pids[started] = start_stage(stage, in, fds[1], fds[0],
+				&codes[started]);
+		if (in != STDIN_FILENO)
+		{
+			close(in);
+		}
+		if (fds[1] != STDOUT_FILENO)
+		{
+			close(fds[1]);
+		}
+		in = fds[0];
+	}
+	if (started < n && in != STDIN_FILENO)
+	{
+		close(in);
+	}
+	return (started);
+}
+
+/**
+ * run_pipeline - Runs the stages of a pipeline concurrently and reaps
+ * them together.
+ * @stage: The first stage.
+ * Return: The exit status of the last stage.
+ */
+int run_pipeline(cmd_t *stage)
+{
+	int *codes, n = 0, started, i, status;
+	unsigned long start;
+	pid_t *pids;
+	cmd_t *s;
+
+	for (s = stage; s != NULL; s = s->next)
+	{
+		n++;
+	}
+	pids = arena_alloc(n * sizeof(*pids));
+	codes = arena_alloc(n * sizeof(*codes));
+	_flush_out();
+	started = start_pipeline(stage, n, pids, codes, STDIN_FILENO);
+	start = TRACE_START();
+	for (i = 0; i < started; i++)
+	{
+		if (pids[i] != -1 && waitpid(pids[i], &status, 0) != -1)
+		{
+			codes[i] = wait_status(status);
+		}
+	}
+	TRACE_END(TRACE_WAIT, start);
+	return (started < n ? 1 : codes[n - 1]);
+}
+
+/**
+ * run_list - Runs a command list, skipping each pipeline joined by
+ * "&&" after a failure or by "||" after a success. A pipeline ended
+ * by '&' is started as a background job. With HSH_TRACE set to a
+ * descriptor, each pipeline run gets its own JSON line.
+ * @list: The first element of the list.
+ * @progname: The name of the program.
+ * Return: The exit status of the last pipeline run.
+ */
+int run_list(list_node_t *list, const char *progname)
+{
+	shell_t *shell = get_shell();
+
+	for (; list != NULL; list = list->next)
+	{
+		if ((list->op == LIST_AND && shell->status != 0)
+				|| (list->op == LIST_OR && shell->status == 0))
+		{
+			continue;
+		}
+		if (list->background)
+		{
+			shell->status = run_background(list->pipeline);
+		}
+		else if (list->pipeline->next != NULL)
+		{
+			shell->status = run_pipeline(list->pipeline);
+		}
+		else
+		{
+			shell->exec_tail = shell->last_line
+				&& list->next == NULL;
+			shell->status = cmd_check(list->pipeline, progname);
+			shell->exec_tail = 0;
+		}
+		if (TRACE_ON)
+		{
+			trace_command_end();
+		}
+	}
+	return (shell->status);
+}
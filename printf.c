@@ -0,0 +1,224 @@
+#include "shell.h"
+
+/**
+ * print_escape - Prints the character denoted by a backslash escape.
+ * @sp: Points just past the backslash; advanced past the escape.
+ */
+static void print_escape(const char **sp)
+{
+	static const char from[] = "abfnrtv\\\"'";
+	static const char to[] = "\a\b\f\n\r\t\v\\\"'";
+	const char *s = *sp, *hit = *s != '\0' ? _strchr(from, *s) : NULL;
+	int value = 0, digits = 0;
+
+	if (hit != NULL)
+	{
+		_putchar(to[hit - from]);
+		*sp = s + 1;
+		return;
+	}
+	while (digits < 3 && s[digits] >= '0' && s[digits] <= '7')
+	{
+		value = value * 8 + (s[digits] - '0');
+		digits++;
+	}
+	if (digits == 0)
+	{
+		_putchar('\\');
+		return;
+	}
+	_putchar((char)value);
+	*sp = s + digits;
+}
+
+/**
+ * printf_number - Converts a printf argument to a number.
+ * A leading quote yields the code of the following character.
+ * @arg: The argument, or NULL if the arguments ran out.
+ * @floating: Non-zero to convert it to @real rather than an integer.
+ * @real: Where to store the number for a floating-point conversion.
+ * @status: Set to 1 if the argument is not a valid number.
+ * Return: The number, for an integer conversion.
+ */
+static long printf_number(const char *arg, int floating, double *real,
+		int *status)
+{
+	char *end;
+	long value = 0;
+
+	*real = 0;
+	if (arg == NULL)
+	{
+		return (0);
+	}
+	if (arg[0] == '\'' || arg[0] == '"')
+	{
+		*real = (unsigned char)arg[1];
+		return ((unsigned char)arg[1]);
+	}
+	errno = 0;
+	if (floating)
+	{
+		*real = strtod(arg, &end);
+	}
+	else
+	{
+		value = strtol(arg, &end, 0);
+	}
+	if (arg[0] == '\0' || *end != '\0' || errno != 0)
+	{
+		builtin_err("printf", arg, ": invalid number");
+		*status = 1;
+	}
+	return (value);
+}
+
+/**
+ * printf_directive - Prints one conversion of a printf format. The
+ * first snprintf() measures the output, the second prints it into the
+ * command arena.
+ * @spec: The directive, from '%' to the conversion character.
+ * @len: The length of @spec.
+ * @arg: The argument to convert, or NULL if they ran out.
+ * @status: Set to 1 on an invalid argument.
+ */
+static void printf_directive(const char *spec, size_t len, const char *arg,
+		int *status)
+{
+	char *fmt = arena_alloc(len + 2), conv = spec[len - 1], *out;
+	char *text = NULL;
+	int floating = _strchr(PRINTF_FLOAT_CONV, conv) != NULL, n;
+	size_t size;
+	double real = 0;
+	long value = 0;
+
+	_memcpy(fmt, spec, len);
+	fmt[len] = '\0';
+	if (conv == 's' || conv == 'c')
+	{
+		text = arena_strdup(arg != NULL ? arg : "");
+		if (conv == 'c' && text[0] != '\0')
+		{
+			text[1] = '\0';
+		}
+		fmt[len - 1] = 's';
+	}
+	else
+	{
+		value = printf_number(arg, floating, &real, status);
+	}
+	if (text == NULL && !floating)
+	{
+		fmt[len - 1] = 'l';
+		fmt[len] = conv;
+		fmt[len + 1] = '\0';
+	}
+	for (out = NULL, size = 0; ; size = n + 1, out = arena_alloc(size))
+	{
+		n = text != NULL ? snprintf(out, size, fmt, text) : floating
+			? snprintf(out, size, fmt, real)
+			: snprintf(out, size, fmt, value);
+		if (out != NULL)
+		{
+			break;
+		}
+	}
+	_write_out(out, n);
+}
+
+/**
+ * printf_format - Prints a printf format once, consuming arguments.
+ * @fmt: The format.
+ * @argp: The next argument; advanced past each one consumed.
+ * @status: Set to 1 on an invalid argument or directive.
+ * Return: 0 to go on, 1 if an invalid directive ended the output.
+ */
+static int printf_format(const char *fmt, char ***argp, int *status)
+{
+	const char *spec;
+
+	while (*fmt != '\0')
+	{
+		if (*fmt == '\\')
+		{
+			fmt++;
+			print_escape(&fmt);
+			continue;
+		}
+		if (*fmt != '%' || fmt[1] == '%')
+		{
+			_putchar(*fmt);
+			fmt += *fmt == '%' ? 2 : 1;
+			continue;
+		}
+		spec = fmt++;
+		while (*fmt != '\0' && _strchr("-+ #0123456789.", *fmt) != NULL)
+		{
+			fmt++;
+		}
+		if (*fmt == '\0' || _strchr(PRINTF_CONV, *fmt) == NULL)
+		{
+			builtin_err("printf", spec, ": invalid directive");
+			*status = 1;
+			return (1);
+		}
+		fmt++;
+		printf_directive(spec, fmt - spec, **argp, status);
+		if (**argp != NULL)
+		{
+			(*argp)++;
+		}
+	}
+	return (0);
+}
+
+/**
+ * handle_printf - Handles the 'printf' built-in command.
+ * The format is reused as long as arguments remain. A format using
+ * anything the built-in does not implement (%b, '*' widths, the \c,
+ * \x, \u and \U escapes, or an unknown conversion) is left to the
+ * external printf, before anything is printed.
+ * @args: Array of command arguments.
+ * Return: 0 on success, 1 on an invalid argument, or BUILTIN_EXTERNAL.
+ */
+int handle_printf(char **args)
+{
+	char **arg, **before;
+	const char *p;
+	int status = 0;
+
+	if (args[1] == NULL)
+	{
+		builtin_err("printf", "missing operand", "");
+		return (1);
+	}
+	for (p = args[1]; *p != '\0'; p++)
+	{
+		if (*p == '\\' && p[1] != '\0' && _strchr("cxuU", p[1]) != NULL)
+		{
+			return (BUILTIN_EXTERNAL);
+		}
+		if (*p != '%' || p[1] == '%')
+		{
+			p += (*p == '\\' || *p == '%') && p[1] != '\0';
+			continue;
+		}
+		while (p[1] != '\0' && _strchr("-+ #0123456789.", p[1]) != NULL)
+		{
+			p++;
+		}
+		if (p[1] == '\0' || _strchr(PRINTF_CONV, *++p) == NULL)
+		{
+			return (BUILTIN_EXTERNAL);
+		}
+	}
+	arg = args + 2;
+	do {
+		before = arg;
+		if (printf_format(args[1], &arg, &status))
+		{
+			break;
+		}
+	} while (*arg != NULL && arg != before);
+	return (status);
+}
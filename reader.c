@@ -0,0 +1,131 @@
+#include "shell.h"
+
+/**
+ * get_reader - Returns the shell's input reader.
+ * Return: A pointer to the reader instance.
+ */
+reader_t *get_reader(void)
+{
+	static reader_t reader = {STDIN_FILENO, {0}, 0, 0, {NULL, 0, 0},
+		NULL, 0, 0};
+
+	return (&reader);
+}
+
+/**
+ * wait_input - Blocks until input is ready, reaping background jobs
+ * that finish in the meantime, so that they do not linger as zombies
+ * while the shell waits at a prompt.
+ * @fd: The input descriptor.
+ */
+static void wait_input(int fd)
+{
+	shell_t *shell = get_shell();
+	struct pollfd fds[2];
+
+	while (shell->running_jobs > 0)
+	{
+		fds[0].fd = fd;
+		fds[0].events = POLLIN;
+		fds[1].fd = shell->chld_pipe[0];
+		fds[1].events = POLLIN;
+		if (poll(fds, 2, -1) > 0 && !(fds[1].revents & POLLIN))
+		{
+			return;
+		}
+		jobs_reap();
+	}
+}
+
+/**
+ * reader_fill - Reads the next block of input into the reader buffer.
+ * @r: The reader.
+ * Return: The number of bytes read, 0 on end-of-file or error.
+ */
+static ssize_t reader_fill(reader_t *r)
+{
+	ssize_t n;
+
+	wait_input(r->fd);
+	n = read(r->fd, r->buf, BUFSIZ);
+
+	r->pos = 0;
+	r->len = n > 0 ? (size_t)n : 0;
+	return (n > 0 ? n : 0);
+}
+
+/**
+ * reader_at_eof - Tells, without blocking, whether the input is known
+ * to be exhausted after the line just read: the script mapping is used
+ * up and the file has not grown, a regular file's offset has reached
+ * its size, or a pipe has hung up with nothing left in it. A terminal
+ * never is.
+ * Return: 1 if no more input can follow, 0 if some may.
+ */
+int reader_at_eof(void)
+{
+	reader_t *r = get_reader();
+	struct pollfd fds;
+	struct stat st;
+
+	if (r->map != NULL)
+	{
+		return (r->pos >= r->map_len && fstat(r->fd, &st) == 0
+				&& st.st_size <= (off_t)r->map_len);
+	}
+	if (r->pos < r->len || fstat(r->fd, &st) == -1)
+	{
+		return (0);
+	}
+	if (S_ISREG(st.st_mode))
+	{
+		return (lseek(r->fd, 0, SEEK_CUR) >= st.st_size);
+	}
+	fds.fd = r->fd;
+	fds.events = POLLIN;
+	return (S_ISFIFO(st.st_mode) && poll(&fds, 1, 0) == 1
+			&& fds.revents == POLLHUP);
+}
+
+/**
+ * read_line - Reads a line of input from the user.
+ *
+ * The returned line points into the reader's block buffer, or into its
+ * carry buffer when the line crosses a block boundary, and stays valid
+ * until the next call.
+ * Return: A pointer to the input line, or NULL on end-of-file.
+ */
+char *read_line(void)
+{
+	reader_t *r = get_reader();
+	char *line, *nl;
+
+	r->carry.len = 0;
+	if (r->map != NULL)
+	{
+		return (map_read_line(r));
+	}
+	while (1)
+	{
+		if (r->pos >= r->len && reader_fill(r) == 0)
+		{
+			return (r->carry.len > 0 ? r->carry.data : NULL);
+		}
+		line = r->buf + r->pos;
+		nl = _memchr(line, '\n', r->len - r->pos);
+		if (nl == NULL)
+		{
+			buf_append(&r->carry, line, r->len - r->pos);
+			r->pos = r->len;
+			continue;
+		}
+		*nl = '\0';
+		r->pos = nl - r->buf + 1;
+		if (r->carry.len == 0)
+		{
+			return (line);
+		}
+		buf_append(&r->carry, line, nl - line);
+		return (r->carry.data);
+	}
+}
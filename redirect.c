@@ -0,0 +1,122 @@
+#include "shell.h"
+
+/**
+ * redir_error - Reports a redirection target that could not be opened.
+ * @target: The file name.
+ * @action: "open" or "create".
+ */
+static void redir_error(const char *target, const char *action)
+{
+	const char *parts[10];
+	char line[ITOA_SIZE];
+	int n = err_prefix(parts, get_shell()->progname, line);
+
+	parts[n++] = "cannot ";
+	parts[n++] = action;
+	parts[n++] = " ";
+	parts[n++] = target;
+	parts[n++] = ": ";
+	parts[n++] = strerror(errno);
+	parts[n++] = "\n";
+	write_err(parts, n);
+}
+
+/**
+ * open_redirs - Opens the files a command's redirections name, in the
+ * shell, so that a failure can be reported before anything runs.
+ *
+ * The descriptors are close-on-exec; each one reaches the command
+ * only through the dup2() that puts it in place.
+ * @redir: The first redirection.
+ * Return: 0 on success, 2 if a file could not be opened (the files
+ * opened before it are closed again).
+ */
+int open_redirs(redir_t *redir)
+{
+	redir_t *first = redir;
+	char *target;
+	int flags;
+
+	for (; redir != NULL; redir = redir->next)
+	{
+		redir->saved = -1;
+		if (redir->kind == REDIR_DUP)
+		{
+			redir->source = STDOUT_FILENO;
+			continue;
+		}
+		target = redir->target;
+		if (_strchr(target, '$') != NULL)
+		{
+			target = arena_strdup(expand_vars(target));
+		}
+		flags = redir->kind == REDIR_IN ? O_RDONLY : O_WRONLY | O_CREAT
+			| (redir->kind == REDIR_APPEND ? O_APPEND : O_TRUNC);
+		redir->source = open(target, flags | O_CLOEXEC, 0666);
+		if (redir->source == -1)
+		{
+			redir_error(target, redir->kind == REDIR_IN
+					? "open" : "create");
+			close_redirs(first);
+			return (2);
+		}
+	}
+	return (0);
+}
+
+/**
+ * close_redirs - Closes the shell's copies of the files a command's
+ * redirections opened.
+ * @redir: The first redirection.
+ */
+void close_redirs(redir_t *redir)
+{
+	for (; redir != NULL; redir = redir->next)
+	{
+		if (redir->kind != REDIR_DUP && redir->source != -1)
+		{
+			close(redir->source);
+		}
+		redir->source = -1;
+	}
+}
+
+/**
+ * apply_redirs - Puts a command's opened redirections in place, in
+ * order, so that "2>&1" copies whatever standard output is by then.
+ * @redir: The first redirection.
+ * @save: Non-zero to keep a copy of each descriptor replaced, for
+ * restore_redirs().
+ */
+void apply_redirs(redir_t *redir, int save)
+{
+	for (; redir != NULL; redir = redir->next)
+	{
+		if (save)
+		{
+			redir->saved = fcntl(redir->fd, F_DUPFD_CLOEXEC, 10);
+		}
+		dup2(redir->source, redir->fd);
+	}
+}
+
+/**
+ * restore_redirs - Undoes apply_redirs(), last redirection first.
+ * @redir: The first redirection.
+ */
+void restore_redirs(redir_t *redir)
+{
+	if (redir == NULL)
+	{
+		return;
+	}
+	restore_redirs(redir->next);
+	if (redir->saved == -1)
+	{
+		close(redir->fd);
+		return;
+	}
+	dup2(redir->saved, redir->fd);
+	close(redir->saved);
+	redir->saved = -1;
+}
@@ -0,0 +1,147 @@
+#include "shell.h"
+
+/*
+ * Where map_read_line() resumes if the script file shrinks under the
+ * mapping, and whether it is reading the mapping at all.
+ */
+static sigjmp_buf map_fault;
+static volatile sig_atomic_t map_armed;
+
+/**
+ * on_sigbus - Handles SIGBUS: while the script mapping is being read,
+ * it means the file was truncated, and map_read_line() resumes with
+ * the file read as a stream. Any other SIGBUS is fatal as usual.
+ * @sig: The signal number.
+ */
+static void on_sigbus(int sig)
+{
+	if (map_armed)
+	{
+		siglongjmp(map_fault, 1);
+	}
+	signal(sig, SIG_DFL);
+}
+
+/**
+ * open_script - Makes a script file the shell's input.
+ *
+ * Regular files are memory-mapped, so lines are found without read()
+ * calls; pipes, FIFOs and anything else that cannot be mapped are read
+ * as a stream. The file stays open, to be read as a stream once the
+ * mapping is used up or if the file is truncated while it runs.
+ * Exits with status 127 if the file cannot be opened.
+ * @progname: The name of the program.
+ * @path: The path of the script file.
+ */
+void open_script(const char *progname, const char *path)
+{
+	reader_t *r = get_reader();
+	const char *parts[7];
+	char line[ITOA_SIZE];
+	struct sigaction sa;
+	struct stat st;
+	void *map;
+	int fd = open(path, O_RDONLY | O_CLOEXEC), n;
+
+	if (fd == -1)
+	{
+		n = err_prefix(parts, progname, line);
+		parts[n++] = "Can't open ";
+		parts[n++] = path;
+		parts[n++] = "\n";
+		write_err(parts, n);
+		exit(127);
+	}
+	r->fd = fd;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+	{
+		return;
+	}
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+			fd, 0);
+	if (map == MAP_FAILED)
+	{
+		return;
+	}
+	r->map = map;
+	r->map_len = st.st_size;
+	sa.sa_handler = on_sigbus;
+	sigemptyset(&sa.sa_mask);
+	sa.sa_flags = SA_NODEFER;
+	sigaction(SIGBUS, &sa, NULL);
+}
+
+/**
+ * map_release - Gives back the mapped pages that lie entirely
+ * before the current line, so memory use follows the current command
+ * rather than the size of the script.
+ * @r: The reader.
+ * @line_off: Offset of the current line in the mapping.
+ */
+static void map_release(reader_t *r, size_t line_off)
+{
+	size_t page = sysconf(_SC_PAGESIZE);
+	size_t upto = line_off / page * page;
+
+	if (upto - r->released >= page * 16)
+	{
+		madvise(r->map + r->released, upto - r->released,
+				MADV_DONTNEED);
+		r->released = upto;
+	}
+}
+
+/**
+ * map_end - Stops reading the script through its mapping and reads
+ * the rest of it as a stream, from a given offset.
+ * @r: The reader.
+ * @offset: The offset in the file to continue from.
+ */
+static void map_end(reader_t *r, size_t offset)
+{
+	map_armed = 0;
+	munmap(r->map, r->map_len);
+	r->map = NULL;
+	lseek(r->fd, offset, SEEK_SET);
+	r->pos = 0;
+	r->len = 0;
+}
+
+/**
+ * map_read_line - Reads the next line of a memory-mapped script.
+ *
+ * The line is found in the mapping and copied out of it, into the
+ * carry buffer, so nothing but this function touches the mapping:
+ * truncating the file drops even the pages already read, and a fault
+ * here is caught. If the file was truncated, the rest of it is read as
+ * a stream from the same offset instead, which finds its new end. Once
+ * the mapping is used up, the file is read as a stream from where the
+ * mapping ended, so lines appended while the script runs are run too.
+ * @r: The reader.
+ * Return: A pointer to the line, or NULL at the end of the script.
+ */
+char *map_read_line(reader_t *r)
+{
+	char *line, *nl;
+	size_t len;
+
+	if (r->pos >= r->map_len)
+	{
+		map_end(r, r->map_len);
+		return (read_line());
+	}
+	if (sigsetjmp(map_fault, 0) != 0)
+	{
+		map_end(r, r->pos);
+		return (read_line());
+	}
+	map_armed = 1;
+	line = r->map + r->pos;
+	map_release(r, r->pos);
+	nl = _memchr(line, '\n', r->map_len - r->pos);
+	len = (nl != NULL ? nl : r->map + r->map_len) - line;
+	buf_append(&r->carry, line, len);
+	map_armed = 0;
+	r->pos += len + 1;
+	return (r->carry.data);
+}
@@ -1,39 +1,161 @@
 #include "shell.h"
 
 /**
- * main - Entry point of the shell program
+ * get_shell - Returns the shell-wide state.
+ * Return: A pointer to the state.
+ */
+shell_t *get_shell(void)
+{
+	static shell_t shell;
+
+	return (&shell);
+}
+
+/**
+ * print_alloc_stats - Reports the number of heap allocations made,
+ * unless called from a forked child that exits.
+ */
+static void print_alloc_stats(void)
+{
+	const char *parts[3];
+	char count[ITOA_SIZE];
+
+	if (getpid() != get_shell()->pid)
+	{
+		return;
+	}
+	parts[0] = "allocations: ";
+	parts[1] = _itoa(alloc_count(0), count);
+	parts[2] = "\n";
+	write_err(parts, 3);
+}
+
+/**
+ * parse_options - Parses the command-line options: -j N runs the input
+ * as a parallel batch of N jobs at a time, and -u emits each job's
+ * output as soon as it finishes rather than in input order.
  * @argc: Number of command-line arguments
  * @argv: Array of command-line arguments
- *
- * Return: EXIT_SUCCESS upon successful completion
+ * @slots: Where to store N, or 0 without -j.
+ * @unordered: Where to store whether -u was given.
+ * Return: The index of the first argument that is not an option.
  */
-int main(int argc, char *argv[])
+static int parse_options(int argc, char *argv[], int *slots, int *unordered)
 {
-	char *input, **args, *progname = argv[0];
-	int interactive = isatty(STDIN_FILENO);
+	int i;
+
+	*slots = 0;
+	*unordered = 0;
+	for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+	{
+		if (_strcmp(argv[i], "-u") == 0)
+		{
+			*unordered = 1;
+			continue;
+		}
+		if (_strcmp(argv[i], "-j") != 0 || i + 1 == argc
+				|| _atoi(argv[i + 1]) < 1)
+		{
+			print_custom_err("Usage: hsh [-j N [-u]] [script]\n");
+			exit(2);
+		}
+		*slots = _atoi(argv[++i]);
+	}
+	return (i);
+}
+
+/**
+ * shell_loop - Reads, parses and runs input lines until the input ends.
+ * @progname: The name of the program.
+ * @interactive: Non-zero to prompt and report finished jobs.
+ * @may_exec: Non-zero if the last command of the input may replace
+ * the shell, when nothing is left to run or report after it.
+ */
+static void shell_loop(const char *progname, int interactive, int may_exec)
+{
+	char *input, **tokens;
+	unsigned long start;
+	list_node_t *list;
 
-	(void)argc;
-	signal(SIGINT, SIG_DFL);
 	while (1)
 	{
+		jobs_reap();
 		if (interactive)
 		{
+			jobs_notify();
+			_flush_out();
 			write(STDOUT_FILENO, "$ ", 2);
-			fflush(stdout);
 		}
+		start = TRACE_START();
 		input = read_line();
+		TRACE_END(TRACE_READ, start);
 		if (input == NULL)
 		{
-			if (interactive)
-			{
-				write(STDOUT_FILENO, "\n", 1);
-			}
-			free(input);
 			break;
 		}
-		args = split_input(input);
-		cmd_check(args, progname);
-		free_memory(input, args);
+		get_shell()->line_count++;
+		get_shell()->last_line = may_exec && reader_at_eof();
+		start = TRACE_START();
+		tokens = split_input(input);
+		TRACE_END(TRACE_SPLIT, start);
+		if (parse_list(tokens, &list) != 0)
+		{
+			get_shell()->status = 2;
+		}
+		else
+		{
+			run_list(list, progname);
+		}
+		if (TRACE_ON)
+		{
+			trace_line_end();
+		}
+		arena_reset();
+	}
+}
+
+/**
+ * main - Entry point of the shell program
+ * @argc: Number of command-line arguments
+ * @argv: Array of command-line arguments
+ *
+ * Return: The exit status of the last command
+ */
+int main(int argc, char *argv[])
+{
+	char *progname = argv[0], *stats;
+	int interactive = isatty(STDIN_FILENO), slots, unordered;
+	int first = parse_options(argc, argv, &slots, &unordered);
+
+	get_shell()->progname = progname;
+	get_shell()->pid = getpid();
+	get_shell()->chld_pipe[0] = -1;
+	get_shell()->chld_pipe[1] = -1;
+	if (first < argc)
+	{
+		open_script(progname, argv[first]);
+		interactive = 0;
+	}
+	env_init();
+	stats = _getenv("HSH_ALLOC_STATS");
+	if (stats != NULL)
+	{
+		atexit(print_alloc_stats);
+	}
+	trace_init();
+	if (slots > 0)
+	{
+		return (run_batch(slots, unordered));
+	}
+	get_shell()->interactive = interactive;
+	set_out_mode(interactive);
+	signal(SIGINT, SIG_DFL);
+	shell_loop(progname, interactive,
+			!interactive && stats == NULL && !trace_enabled);
+	if (interactive)
+	{
+		_putchar('\n');
 	}
-	return (EXIT_SUCCESS);
+	_flush_out();
+	return (get_shell()->status);
 }
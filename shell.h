@@ -1,57 +1,611 @@
 #ifndef SHELL_H
 #define SHELL_H
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <errno.h>
+#include <spawn.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include <signal.h>
+#include <setjmp.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <limits.h>
+#include <sys/sendfile.h>
+#include <poll.h>
 
 #define BUFFER_SIZE 1024
+#define ITOA_SIZE 12
+#define ERR_PARTS_MAX 16
+#define ERR_PREFIX_PARTS 4
+#define HASH_BUCKETS 64
+#define ENV_BUCKETS 128
+#define ENV_CHUNK_SIZE 4096
+#define ARENA_SIZE 16384
+#define SWAR_ONES ((word_t)-1 / 0xff)
+#define SWAR_HAS_ZERO(w) (((w) - SWAR_ONES) & ~(w) & (SWAR_ONES * 0x80))
+#define NEAR_PAGE_END(p) (((size_t)(p) & 4095) > 4096 - sizeof(word_t))
+#define NO_ASAN __attribute__((no_sanitize_address))
+#define BUILTIN_SLOTS 32
+#define BUILTIN_SLOTS_MAX 256
+#define BUILTIN_HASH_TRIES 64
+#define TABLE_HASHED 1
+#define TABLE_LINEAR 2
+#define DELIM_BITS (8 * sizeof(unsigned long))
+#define DELIM_WORDS (256 / 8 / sizeof(unsigned long))
+#define DELIM_SIMD_MAX 12
+#define BLANK_CHARS " \t\r\n\a\""
+#define OPERATOR_CHARS ";&|<>"
+#define LIST_SEQ 0
+#define LIST_AND 1
+#define LIST_OR 2
+#define LIST_PIPE 3
+#define LIST_BG 4
+#define REDIR_IN 5
+#define REDIR_OUT 6
+#define REDIR_APPEND 7
+#define REDIR_DUP 8
+#define JOBS_KEEP_DONE 1024
+#define BATCH_WINDOW 16
+#define BATCH_FREE 0
+#define BATCH_RUNNING 1
+#define BATCH_DONE 2
+#define CAT_CHUNK (1 << 30)
+#define BUILTIN_EXTERNAL (-1)
+#define PRINTF_FLOAT_CONV "fFeEgG"
+#define PRINTF_CONV "diouxXcsfFeEgG"
+#define TEST_UNARY_OPS "znrwxtefdbcpShLsgukOG"
+#define TEST_ERROR(msg, detail) (builtin_err("test", (msg), (detail)), 2)
+#define PARALLEL_MAX_BYTES (128 * 1024)
+#define PARALLEL_HEADROOM 2048
+#define PARALLEL_STOP 126
+#define TRACE_READ 0
+#define TRACE_SPLIT 1
+#define TRACE_EXPAND 2
+#define TRACE_DISPATCH 3
+#define TRACE_LOOKUP 4
+#define TRACE_SPAWN 5
+#define TRACE_WAIT 6
+#define TRACE_STAGES 7
+#define TRACE_BUCKETS 64
+#define TRACE_NUM_SIZE 24
+#define TRACE_ON __builtin_expect(trace_enabled, 0)
+#define TRACE_START() (TRACE_ON ? trace_clock() : 0UL)
+#define TRACE_END(stage, start) do { \
+		if (TRACE_ON) \
+			trace_record(stage, start); \
+	} while (0)
+#define DELIM_HAS(set, c) (((set)->bits[(unsigned char)(c) / DELIM_BITS] \
+		>> ((unsigned char)(c) % DELIM_BITS)) & 1)
 
 extern char **environ;
+extern int trace_enabled;
+
+/*
+ * word_t - A machine word that may be loaded from any address and
+ * may alias any other type, for word-at-a-time string routines.
+ */
+typedef unsigned long __attribute__((__may_alias__, __aligned__(1))) word_t;
+
+/**
+ * struct buf_s - A growable buffer that tracks its own capacity.
+ * @data: The bytes held.
+ * @len: The number of bytes in use.
+ * @cap: The number of bytes allocated.
+ */
+typedef struct buf_s
+{
+	char *data;
+	size_t len;
+	size_t cap;
+} buf_t;
+
+/**
+ * struct out_s - The shell's standard output buffer.
+ * @buf: The bytes not yet written.
+ * @len: The number of bytes in @buf.
+ * @line_mode: Non-zero to flush at every newline.
+ */
+typedef struct out_s
+{
+	char buf[BUFSIZ];
+	size_t len;
+	int line_mode;
+} out_t;
+
+/**
+ * struct delim_set_s - A compiled set of delimiter characters.
+ * @bits: Bitmap with one bit per byte value.
+ * @chars: The first DELIM_SIMD_MAX characters, for vector scanning.
+ * @nchars: The number of characters in the set.
+ * @compiled: Non-zero once the set has been filled in.
+ */
+typedef struct delim_set_s
+{
+	unsigned long bits[DELIM_WORDS];
+	char chars[DELIM_SIMD_MAX];
+	int nchars;
+	int compiled;
+} delim_set_t;
+
+/**
+ * struct span_s - A token inside a larger string.
+ * @start: The first byte of the token.
+ * @len: The length of the token.
+ */
+typedef struct span_s
+{
+	const char *start;
+	size_t len;
+} span_t;
+
+/**
+ * struct reader_s - Block-buffered line reader.
+ * @fd: The file descriptor lines are read from.
+ * @buf: The current input block.
+ * @pos: Offset of the first unread byte in @buf.
+ * @len: Number of valid bytes in @buf.
+ * @carry: Buffer stitching together lines that cross a block boundary.
+ * @map: Memory-mapped script file, or NULL when reading a stream.
+ * @map_len: Size of @map.
+ * @released: Offset up to which @map pages have been given back.
+ */
+typedef struct reader_s
+{
+	int fd;
+	char buf[BUFSIZ];
+	size_t pos;
+	size_t len;
+	buf_t carry;
+	char *map;
+	size_t map_len;
+	size_t released;
+} reader_t;
+
+/**
+ * struct hash_entry_s - Cached command path lookup.
+ * @name: The command name.
+ * @path: The full path the command resolved to, or NULL if the
+ * command was not found in PATH.
+ * @hits: The number of times the entry was used.
+ * @dir_sig: Signature of the PATH directories when a miss was recorded.
+ * @stamp: When a miss was last confirmed.
+ * @next: The next entry in the same bucket.
+ */
+typedef struct hash_entry_s
+{
+	char *name;
+	char *path;
+	int hits;
+	unsigned long dir_sig;
+	time_t stamp;
+	struct hash_entry_s *next;
+} hash_entry_t;
+
+/**
+ * struct path_dir_s - A PATH directory opened for lookups.
+ * @name: The directory as written in PATH.
+ * @fd: An O_PATH descriptor for the directory, or -1 if it is
+ * relative or could not be opened.
+ */
+typedef struct path_dir_s
+{
+	char *name;
+	int fd;
+} path_dir_t;
+
+/**
+ * struct env_var_s - A variable in the environment store.
+ * @entry: The "NAME=value" string, held in the store's arena.
+ * @name_len: The length of the name part of @entry.
+ * @next: The next variable in the same hash bucket.
+ * @before: The previously defined variable.
+ * @after: The next defined variable.
+ */
+typedef struct env_var_s
+{
+	char *entry;
+	size_t name_len;
+	struct env_var_s *next;
+	struct env_var_s *before;
+	struct env_var_s *after;
+} env_var_t;
+
+/**
+ * struct env_chunk_s - A block of the environment string arena.
+ * The strings follow the header in the same allocation.
+ * @size: The number of bytes the chunk can hold.
+ * @used: The number of bytes handed out.
+ * @next: The previously allocated chunk.
+ */
+typedef struct env_chunk_s
+{
+	size_t size;
+	size_t used;
+	struct env_chunk_s *next;
+} env_chunk_t;
+
+/**
+ * struct env_store_s - The shell's own environment.
+ * @buckets: Hash table of variables keyed by name.
+ * @first: The first variable in definition order.
+ * @last: The last variable in definition order.
+ * @count: The number of variables.
+ * @chunks: The arena holding the "NAME=value" strings.
+ * @live: Bytes of the arena used by current strings.
+ * @used: Bytes of the arena handed out, including stale strings.
+ * @generation: Incremented on every change.
+ * @envp: Cached array of the strings, in definition order.
+ * @envp_generation: The @generation @envp was built for.
+ */
+typedef struct env_store_s
+{
+	env_var_t *buckets[ENV_BUCKETS];
+	env_var_t *first;
+	env_var_t *last;
+	int count;
+	env_chunk_t *chunks;
+	size_t live;
+	size_t used;
+	unsigned long generation;
+	buf_t envp;
+	unsigned long envp_generation;
+} env_store_t;
+
+/**
+ * struct arena_block_s - An overflow block of the command arena.
+ * The memory handed out follows the header in the same allocation.
+ * @next: The previously allocated overflow block.
+ */
+typedef struct arena_block_s
+{
+	struct arena_block_s *next;
+} arena_block_t;
+
+/**
+ * struct job_s - A pipeline running in the background.
+ * @id: The job number, as in "%1".
+ * @pids: The process ID of each stage; -1 once reaped or if the stage
+ * was never started.
+ * @pid: The process ID of the last stage, as $! reports it, or -1.
+ * @count: The number of stages.
+ * @running: The number of stages not yet reaped.
+ * @status: The exit status of the last stage, once known.
+ * @command: The command text, for 'jobs'.
+ * @next: The next job, in order of @id.
+ */
+typedef struct job_s
+{
+	int id;
+	pid_t *pids;
+	pid_t pid;
+	int count;
+	int running;
+	int status;
+	char *command;
+	struct job_s *next;
+} job_t;
+
+/**
+ * struct batch_job_s - One line of a parallel batch (hsh -j).
+ * @pid: The process running the line.
+ * @out: Memory file capturing its standard output, or -1.
+ * @err: Memory file capturing its standard error, or -1.
+ * @status: Its exit status, once BATCH_DONE.
+ * @state: BATCH_FREE, BATCH_RUNNING or BATCH_DONE (finished but not
+ * yet emitted).
+ */
+typedef struct batch_job_s
+{
+	pid_t pid;
+	int out;
+	int err;
+	int status;
+	int state;
+} batch_job_t;
+
+/**
+ * struct parallel_s - The state of the 'parallel' built-in.
+ * @path: The resolved command.
+ * @argv: The argument vector of the next worker: the command and its
+ * arguments, then room for the items.
+ * @nargs: The number of command words at the start of @argv.
+ * @text: The pending items, each NUL-terminated.
+ * @count: The number of pending items.
+ * @bytes: The exec size of the command words and pending items.
+ * @fixed_bytes: The exec size of the command words alone.
+ * @limit: The largest exec size to pass to one worker.
+ * @max_items: The most items to pass to one worker, or 0 for no limit.
+ * @pids: The process ID of each worker slot, or -1 if it is free.
+ * @slots: The number of worker slots.
+ * @running: The number of workers running.
+ * @null_fd: /dev/null, the workers' standard input.
+ * @status: The status to return; PARALLEL_STOP or above once the
+ * command could not be run, which stops the built-in.
+ */
+typedef struct parallel_s
+{
+	const char *path;
+	char **argv;
+	int nargs;
+	buf_t text;
+	int count;
+	size_t bytes;
+	size_t fixed_bytes;
+	size_t limit;
+	int max_items;
+	pid_t *pids;
+	int slots;
+	int running;
+	int null_fd;
+	int status;
+} parallel_t;
+
+/**
+ * struct trace_s - The counters behind HSH_TRACE.
+ * @fd: The descriptor to write a JSON line to after each command, or
+ * -1 to print histograms at exit instead.
+ * @hist: For each stage, the number of calls that took from 2^i up to
+ * 2^(i+1) nanoseconds, in bucket i.
+ * @count: The number of calls of each stage.
+ * @total: The total nanoseconds spent in each stage.
+ * @line: The nanoseconds spent in each stage on the current command;
+ * reading and splitting a line count towards its first command.
+ * @line_no: The input line of the last command written.
+ * @command: Its position on that line, from 1.
+ */
+typedef struct trace_s
+{
+	int fd;
+	unsigned long hist[TRACE_STAGES][TRACE_BUCKETS];
+	unsigned long count[TRACE_STAGES];
+	unsigned long total[TRACE_STAGES];
+	unsigned long line[TRACE_STAGES];
+	int line_no;
+	int command;
+} trace_t;
+
+/**
+ * struct shell_s - Shell-wide state.
+ * @progname: The name the shell was invoked as.
+ * @line_count: Number of input lines read so far.
+ * @status: Exit status of the last command, as reported by $?.
+ * @interactive: Non-zero when reading commands from a terminal.
+ * @jobs: The background jobs, finished ones included until reported.
+ * @running_jobs: The number of jobs with stages not yet reaped.
+ * @last_bg: The process ID of the last background job, for $!.
+ * @chld_pipe: The self-pipe the SIGCHLD handler writes to, or -1s.
+ * @last_line: Non-zero while running a line after which the input is
+ * known to end, when its last command may replace the shell.
+ * @exec_tail: Non-zero while running that last command.
+ * @pid: The shell's process ID. Forked children have another, and
+ * must not print the reports registered with atexit().
+ */
+typedef struct shell_s
+{
+	const char *progname;
+	int line_count;
+	int status;
+	int interactive;
+	job_t *jobs;
+	int running_jobs;
+	pid_t last_bg;
+	int chld_pipe[2];
+	int last_line;
+	int exec_tail;
+	pid_t pid;
+} shell_t;
+
+/**
+ * struct operator_s - An operator the tokenizer recognizes.
+ * @text: The operator's canonical string.
+ * @kind: LIST_* for a control operator, REDIR_* for a redirection.
+ * @fd: The descriptor a redirection applies to, or -1.
+ */
+typedef struct operator_s
+{
+	const char *text;
+	int kind;
+	int fd;
+} operator_t;
+
+/**
+ * struct redir_s - A redirection of a simple command.
+ * @fd: The descriptor redirected.
+ * @kind: REDIR_IN, REDIR_OUT, REDIR_APPEND or REDIR_DUP.
+ * @target: The file name, or NULL for REDIR_DUP.
+ * @source: The descriptor put in place of @fd, once opened.
+ * @saved: A copy of the original @fd while a built-in runs, or -1.
+ * @next: The next redirection, applied after this one.
+ */
+typedef struct redir_s
+{
+	int fd;
+	int kind;
+	char *target;
+	int source;
+	int saved;
+	struct redir_s *next;
+} redir_t;
+
+/**
+ * struct cmd_s - A simple command, one stage of a pipeline.
+ * @args: The command's arguments, NULL-terminated.
+ * @redirs: The command's redirections, in order.
+ * @next: The next stage of the pipeline.
+ */
+typedef struct cmd_s
+{
+	char **args;
+	redir_t *redirs;
+	struct cmd_s *next;
+} cmd_t;
+
+/**
+ * struct list_node_s - A pipeline in a list joined by ';', '&&'
+ * and '||'.
+ * @pipeline: The first command of the pipeline.
+ * @op: How the pipeline is joined to the one before it: LIST_SEQ,
+ * LIST_AND or LIST_OR.
+ * @background: Non-zero if the pipeline is followed by '&'.
+ * @next: The next pipeline in the list.
+ */
+typedef struct list_node_s
+{
+	cmd_t *pipeline;
+	int op;
+	int background;
+	struct list_node_s *next;
+} list_node_t;
+
+/**
+ * struct builtin_s - A built-in command.
+ * @name: The command name.
+ * @handler: The function implementing it; returns the exit status.
+ */
+typedef struct builtin_s
+{
+	const char *name;
+	int (*handler)(char **args);
+} builtin_t;
 
-void free_memory(char *input, char **args);
+void *_malloc(size_t size);
+unsigned long alloc_count(int add);
+void *arena_alloc(size_t size);
+char *arena_strdup(const char *str);
+void arena_reset(void);
 char **split_input(char *input);
+char **token_push(char **tokens, int *count, int *size, char *token);
+const char *lex_operator(const char *p);
+const operator_t *find_operator(const char *token);
+int parse_list(char **tokens, list_node_t **list);
+int run_list(list_node_t *list, const char *progname);
+int run_pipeline(cmd_t *stage);
+int start_pipeline(cmd_t *stage, int n, pid_t *pids, int *codes, int in);
+int run_background(cmd_t *stage);
+void jobs_init(void);
+job_t *job_add(cmd_t *stage, pid_t *pids, int *codes, int count);
+void jobs_reap(void);
+void job_reaped(pid_t pid, int status);
+void job_remove(job_t *job);
+void job_print(const job_t *job);
+void jobs_notify(void);
+int handle_wait(char **args);
+int handle_jobs(char **args);
+int handle_parallel(char **args);
+void parallel_run(parallel_t *pl);
+trace_t *get_trace(void);
+unsigned long trace_clock(void);
+void trace_init(void);
+void trace_record(int stage, unsigned long start);
+void trace_report(void);
+void trace_command_end(void);
+void trace_line_end(void);
+int spawn_command(char **args, const char *full_path, int in, int out,
+		redir_t *redirs, pid_t *pid);
+int open_redirs(redir_t *redir);
+void close_redirs(redir_t *redir);
+void apply_redirs(redir_t *redir, int save);
+void restore_redirs(redir_t *redir);
+int handle_cat(char **args);
+int copy_fd(int in, int out);
+int run_batch(int slots, int unordered);
+int wait_status(int status);
+char **expand_args(char **args);
 char *read_line(void);
-void execute_command(char **args, const char *progname);
-void handle_exit(char **args);
-void handle_env(void);
+int reader_at_eof(void);
+reader_t *get_reader(void);
+char *_memchr(const char *s, int c, size_t n);
+void open_script(const char *progname, const char *path);
+char *map_read_line(reader_t *r);
+void buf_reserve(buf_t *b, size_t size);
+void buf_append(buf_t *b, const char *s, size_t n);
+int execute_command(char **args, redir_t *redirs, const char *progname);
+int handle_exit(char **args);
+int handle_env(char **args);
 char *_getenv(const char *name);
-void handle_special_env(const char *name, const char *progname);
 char *get_full_path(const char *command);
-void execute_external_command(char **args, const char *full_path);
-void execute_command(char **args, const char *progname);
-void cmd_check(char **args, const char *progname);
+int execute_external_command(char **args, const char *full_path,
+		redir_t *redirs);
+int cmd_check(cmd_t *cmd, const char *progname);
+int run_builtin(const builtin_t *builtin, char **args, redir_t *redirs);
 void print_err(const char *progname, const char *message, const char *cmd);
-char *_strtok(char *str, const char *delim, char **save_ptr);
-void replace_env_vars(char *input);
-char *get_env_var_value(const char *var_name);
-void replace_env_var(char **start, const char *var_value, char *end);
-void execute_echo(char **args);
-int my_getchar(void);
+void cmd_err(const char *progname, redir_t *redirs, int out,
+		const char *cmd, const char *message);
+void delim_compile(delim_set_t *set, const char *delims);
+int next_token(const delim_set_t *set, const char **cursor, span_t *tok);
+const char *scan_delim(const delim_set_t *set, const char *p);
+char *expand_vars(const char *input);
+char *get_env_var_value(const char *var_name, size_t len);
+int execute_echo(char **args);
 size_t _strlen(const char *str);
 char *_strchr(const char *str, int c);
 char *_strcpy(char *dest, const char *src);
 char *_strncpy(char *dest, const char *src, size_t n);
 int _strncmp(const char *s1, const char *s2, size_t n);
 int _strcmp(const char *s1, const char *s2);
-void *_realloc(void *ptr, size_t size);
+void *_realloc(void *ptr, size_t old_size, size_t new_size);
 char *_strdup(const char *str);
 char *_strcat(char *dest, const char *src);
 int _atoi(const char *str);
 int _puts(const char *str);
 void _putchar(char c);
-char *_itoa(int num);
-void handle_setenv(char **args);
-void handle_unsetenv(char **args);
+void _write_out(const char *s, size_t n);
+void _flush_out(void);
+out_t *get_out(void);
+void _splice_out(void);
+void set_out_mode(int line_buffered);
+char *_itoa(int num, char *buf);
+int handle_setenv(char **args);
+int handle_unsetenv(char **args);
 bool _unsetenv(const char *name);
 bool _setenv(const char *name, const char *value);
 void print_custom_err(const char *message);
+void write_err(const char **parts, int count);
+int err_prefix(const char **parts, const char *progname, char *line);
+void builtin_err(const char *name, const char *msg, const char *detail);
+shell_t *get_shell(void);
+hash_entry_t *hash_lookup(const char *name);
+hash_entry_t *hash_insert(const char *name, const char *path);
+void hash_clear(void);
+int handle_hash(char **args);
+int handle_true(char **args);
+int handle_false(char **args);
+int handle_pwd(char **args);
+int handle_cd(char **args);
+int handle_test(char **args);
+int test_unary_op(const char *op);
+int test_unary(const char *op, const char *arg);
+int test_binary_op(const char *op);
+int test_binary(const char *left, const char *op, const char *right);
+int test_eval(char **argv, int argc);
+int test_file_mode(char op, const struct stat *st);
+int test_file_compare(const char *left, char op, const char *right);
+int handle_printf(char **args);
+void path_changed(void);
+const builtin_t *find_builtin(const char *name);
+path_dir_t *get_path_dirs(int *count);
+env_store_t *get_env_store(void);
+env_var_t *env_find(const char *name, size_t len);
+bool env_put(const char *name, const char *value);
+bool env_remove(const char *name);
+char *env_arena_alloc(size_t size);
+void env_compact(void);
+char **env_envp(void);
+void env_init(void);
 void _memmove(char *dest, const char *src, size_t n);
 void _memcpy(char *dest, const char *src, size_t n);
 int my_isalnum(int c);
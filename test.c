@@ -0,0 +1,150 @@
+#include "shell.h"
+
+/**
+ * test_unary_op - Tells whether a string is a unary 'test' operator.
+ * @op: The candidate operator.
+ * Return: Non-zero if it is one.
+ */
+int test_unary_op(const char *op)
+{
+	return (op[0] == '-' && op[1] != '\0' && op[2] == '\0'
+			&& _strchr(TEST_UNARY_OPS, op[1]) != NULL);
+}
+
+/**
+ * test_unary - Evaluates a unary 'test' primary.
+ * @op: The operator, e.g. "-f".
+ * @arg: The operand.
+ * Return: 0 if true, 1 if false, 2 for an unknown operator.
+ */
+int test_unary(const char *op, const char *arg)
+{
+	struct stat st;
+	int found;
+
+	if (!test_unary_op(op))
+	{
+		return (TEST_ERROR(op, ": unexpected operator"));
+	}
+	if (op[1] == 'z' || op[1] == 'n')
+	{
+		return ((arg[0] == '\0') == (op[1] == 'z') ? 0 : 1);
+	}
+	if (op[1] == 'r')
+	{
+		return (access(arg, R_OK) == 0 ? 0 : 1);
+	}
+	if (op[1] == 'w')
+	{
+		return (access(arg, W_OK) == 0 ? 0 : 1);
+	}
+	if (op[1] == 'x')
+	{
+		return (access(arg, X_OK) == 0 ? 0 : 1);
+	}
+	if (op[1] == 't')
+	{
+		return (isatty(_atoi(arg)) ? 0 : 1);
+	}
+	found = (op[1] == 'h' || op[1] == 'L') ? lstat(arg, &st) == 0
+		: stat(arg, &st) == 0;
+	return (found && test_file_mode(op[1], &st) ? 0 : 1);
+}
+
+/**
+ * test_binary_op - Identifies a binary 'test' operator.
+ * @op: The candidate operator.
+ * Return: Its index in -eq, -ne, -lt, -le, -gt, -ge, =, ==, !=, -nt,
+ * -ot, -ef, or -1 if it is not one.
+ */
+int test_binary_op(const char *op)
+{
+	static const char * const ops[] = {"-eq", "-ne", "-lt", "-le", "-gt",
+		"-ge", "=", "==", "!=", "-nt", "-ot", "-ef"};
+	int i;
+
+	for (i = 0; i < 12; i++)
+	{
+		if (_strcmp(op, ops[i]) == 0)
+		{
+			return (i);
+		}
+	}
+	return (-1);
+}
+
+/**
+ * test_binary - Evaluates a binary 'test' primary.
+ * @left: The left operand.
+ * @op: The operator, e.g. "-eq".
+ * @right: The right operand.
+ * Return: 0 if true, 1 if false, 2 for an invalid expression.
+ */
+int test_binary(const char *left, const char *op, const char *right)
+{
+	int i = test_binary_op(op);
+	long a, b;
+	char *end;
+
+	if (i == -1)
+	{
+		return (TEST_ERROR(op, ": unexpected operator"));
+	}
+	if (i >= 9)
+	{
+		return (test_file_compare(left, op[1], right));
+	}
+	if (i >= 6)
+	{
+		return ((_strcmp(left, right) == 0) == (i < 8) ? 0 : 1);
+	}
+	a = strtol(left, &end, 10);
+	if (left[0] == '\0' || *end != '\0')
+	{
+		return (TEST_ERROR("Illegal number: ", left));
+	}
+	b = strtol(right, &end, 10);
+	if (right[0] == '\0' || *end != '\0')
+	{
+		return (TEST_ERROR("Illegal number: ", right));
+	}
+	switch (i)
+	{
+	case 0:
+		return (a == b ? 0 : 1);
+	case 1:
+		return (a != b ? 0 : 1);
+	case 2:
+		return (a < b ? 0 : 1);
+	case 3:
+		return (a <= b ? 0 : 1);
+	case 4:
+		return (a > b ? 0 : 1);
+	}
+	return (a >= b ? 0 : 1);
+}
+
+/**
+ * handle_test - Handles the 'test' and '[' built-in commands.
+ * @args: Array of command arguments.
+ * Return: 0 if the expression is true, 1 if false, 2 on error.
+ */
+int handle_test(char **args)
+{
+	int argc = 0;
+
+	while (args[argc] != NULL)
+	{
+		argc++;
+	}
+	if (_strcmp(args[0], "[") == 0)
+	{
+		if (_strcmp(args[argc - 1], "]") != 0)
+		{
+			builtin_err("[", "missing ]", "");
+			return (2);
+		}
+		argc--;
+	}
+	return (test_eval(args + 1, argc - 1));
+}
@@ -0,0 +1,175 @@
+#include "shell.h"
+
+static int test_or(char **argv, int argc, int *pos);
+
+/**
+ * test_primary - Parses and evaluates a 'test' primary: a
+ * parenthesized expression, a binary or unary primary, or a string.
+ * @argv: The expression arguments.
+ * @argc: The number of arguments.
+ * @pos: The index of the next argument; advanced past the primary.
+ * Return: 0 if true, 1 if false, 2 for an invalid expression.
+ */
+static int test_primary(char **argv, int argc, int *pos)
+{
+	int r;
+
+	if (*pos >= argc)
+	{
+		return (TEST_ERROR("argument expected", ""));
+	}
+	if (_strcmp(argv[*pos], "(") == 0)
+	{
+		(*pos)++;
+		r = test_or(argv, argc, pos);
+		if (r != 2 && (*pos >= argc || _strcmp(argv[*pos], ")") != 0))
+		{
+			return (TEST_ERROR("closing paren expected", ""));
+		}
+		(*pos)++;
+		return (r);
+	}
+	if (*pos + 2 < argc && test_binary_op(argv[*pos + 1]) != -1)
+	{
+		*pos += 3;
+		return (test_binary(argv[*pos - 3], argv[*pos - 2],
+					argv[*pos - 1]));
+	}
+	if (*pos + 1 < argc && test_unary_op(argv[*pos]))
+	{
+		*pos += 2;
+		return (test_unary(argv[*pos - 2], argv[*pos - 1]));
+	}
+	return (argv[(*pos)++][0] != '\0' ? 0 : 1);
+}
+
+/**
+ * test_and - Parses and evaluates a chain of possibly negated
+ * primaries joined by "-a".
+ * @argv: The expression arguments.
+ * @argc: The number of arguments.
+ * @pos: The index of the next argument; advanced past the chain.
+ * Return: 0 if true, 1 if false, 2 for an invalid expression.
+ */
+static int test_and(char **argv, int argc, int *pos)
+{
+	int r = 0, next, negate;
+
+	while (1)
+	{
+		for (negate = 0; *pos < argc - 1
+				&& _strcmp(argv[*pos], "!") == 0; (*pos)++)
+		{
+			negate = !negate;
+		}
+		next = test_primary(argv, argc, pos);
+		if (next == 2)
+		{
+			return (2);
+		}
+		r = r == 0 && (next == 0) != negate ? 0 : 1;
+		if (*pos >= argc || _strcmp(argv[*pos], "-a") != 0)
+		{
+			return (r);
+		}
+		(*pos)++;
+	}
+}
+
+/**
+ * test_or - Parses and evaluates "-a" chains joined by "-o".
+ * @argv: The expression arguments.
+ * @argc: The number of arguments.
+ * @pos: The index of the next argument; advanced past the expression.
+ * Return: 0 if true, 1 if false, 2 for an invalid expression.
+ */
+static int test_or(char **argv, int argc, int *pos)
+{
+	int r = 1, next;
+
+	while (1)
+	{
+		next = test_and(argv, argc, pos);
+		if (next == 2)
+		{
+			return (2);
+		}
+		r = r == 0 || next == 0 ? 0 : 1;
+		if (*pos >= argc || _strcmp(argv[*pos], "-o") != 0)
+		{
+			return (r);
+		}
+		(*pos)++;
+	}
+}
+
+/**
+ * test_short - Applies the POSIX rules for 'test' expressions of two
+ * to four arguments, which settle "!", "(" and binary operators by
+ * position before any parsing.
+ * @argv: The expression arguments.
+ * @argc: The number of arguments.
+ * Return: 0 if true, 1 if false, 2 for an invalid expression, or -1
+ * if the rules do not apply and the expression must be parsed.
+ */
+static int test_short(char **argv, int argc)
+{
+	int r, left, right;
+
+	if (argc == 3 && test_binary_op(argv[1]) != -1)
+	{
+		return (test_binary(argv[0], argv[1], argv[2]));
+	}
+	if (argc == 3 && (_strcmp(argv[1], "-a") == 0
+				|| _strcmp(argv[1], "-o") == 0))
+	{
+		left = argv[0][0] != '\0';
+		right = argv[2][0] != '\0';
+		return ((argv[1][1] == 'a' ? left && right : left || right)
+				? 0 : 1);
+	}
+	if (_strcmp(argv[0], "!") == 0 && argc > 1)
+	{
+		r = test_eval(argv + 1, argc - 1);
+		return (r == 2 ? 2 : !r);
+	}
+	if (argc > 2 && _strcmp(argv[0], "(") == 0
+			&& _strcmp(argv[argc - 1], ")") == 0)
+	{
+		return (test_eval(argv + 1, argc - 2));
+	}
+	return (-1);
+}
+
+/**
+ * test_eval - Evaluates a 'test' expression: by position for up to
+ * four arguments, as POSIX specifies, and otherwise by parsing "!",
+ * "-a", "-o" and parentheses, "-a" binding tighter than "-o".
+ * @argv: The expression arguments.
+ * @argc: The number of arguments.
+ * Return: 0 if true, 1 if false, 2 for an invalid expression.
+ */
+int test_eval(char **argv, int argc)
+{
+	int pos = 0, r;
+
+	if (argc == 0)
+	{
+		return (1);
+	}
+	if (argc == 1)
+	{
+		return (argv[0][0] != '\0' ? 0 : 1);
+	}
+	r = argc <= 4 ? test_short(argv, argc) : -1;
+	if (r != -1)
+	{
+		return (r);
+	}
+	r = test_or(argv, argc, &pos);
+	if (r != 2 && pos < argc)
+	{
+		return (TEST_ERROR(argv[pos], ": unexpected operator"));
+	}
+	return (r);
+}
@@ -0,0 +1,80 @@
+#include "shell.h"
+
+/**
+ * test_file_mode - Evaluates a 'test' file primary on a file that
+ * exists.
+ * @op: The operator's letter, e.g. 'f' for "-f".
+ * @st: The file's status.
+ * Return: Non-zero if the primary is true.
+ */
+int test_file_mode(char op, const struct stat *st)
+{
+	switch (op)
+	{
+	case 'f':
+		return (S_ISREG(st->st_mode));
+	case 'd':
+		return (S_ISDIR(st->st_mode));
+	case 'b':
+		return (S_ISBLK(st->st_mode));
+	case 'c':
+		return (S_ISCHR(st->st_mode));
+	case 'p':
+		return (S_ISFIFO(st->st_mode));
+	case 'S':
+		return (S_ISSOCK(st->st_mode));
+	case 'h':
+	case 'L':
+		return (S_ISLNK(st->st_mode));
+	case 's':
+		return (st->st_size > 0);
+	case 'g':
+		return ((st->st_mode & S_ISGID) != 0);
+	case 'u':
+		return ((st->st_mode & S_ISUID) != 0);
+	case 'k':
+		return ((st->st_mode & S_ISVTX) != 0);
+	case 'O':
+		return (st->st_uid == geteuid());
+	case 'G':
+		return (st->st_gid == getegid());
+	}
+	return (1);
+}
+
+/**
+ * test_file_compare - Evaluates the 'test' file comparisons, as
+ * coreutils does: "-nt" is true if the left file exists and the right
+ * one does not or is older, "-ot" the other way round, and "-ef" if
+ * both name the same file.
+ * @left: The left file.
+ * @op: The operator's second letter: 'n', 'o' or 'e'.
+ * @right: The right file.
+ * Return: 0 if true, 1 if false.
+ */
+int test_file_compare(const char *left, char op, const char *right)
+{
+	struct stat a, b;
+	int has_a = stat(left, &a) == 0, has_b = stat(right, &b) == 0;
+	int newer;
+
+	if (op == 'e')
+	{
+		return (has_a && has_b && a.st_dev == b.st_dev
+				&& a.st_ino == b.st_ino ? 0 : 1);
+	}
+	if (!has_a || !has_b)
+	{
+		return ((op == 'n' ? has_a : has_b) ? 0 : 1);
+	}
+	newer = a.st_mtim.tv_sec != b.st_mtim.tv_sec
+		? a.st_mtim.tv_sec > b.st_mtim.tv_sec
+		: a.st_mtim.tv_nsec > b.st_mtim.tv_nsec;
+	if (op == 'o')
+	{
+		newer = a.st_mtim.tv_sec != b.st_mtim.tv_sec
+			? a.st_mtim.tv_sec < b.st_mtim.tv_sec
+			: a.st_mtim.tv_nsec < b.st_mtim.tv_nsec;
+	}
+	return (newer ? 0 : 1);
+}
@@ -0,0 +1,14 @@
+#!/bin/sh
+# Builds and runs the string routine test twice: with the SSE2 paths,
+# and with -U__SSE2__ for the word-at-a-time fallbacks.
+cd "$(dirname "$0")/.." || exit 1
+bin=$(mktemp) || exit 1
+trap 'rm -f "$bin"' EXIT
+for flags in "" -U__SSE2__
+do
+	gcc -Wall -Werror -Wextra -pedantic -std=gnu89 $flags \
+		tests/string_test.c functions1.c functions2.c functions3.c \
+		functions4.c memory.c tokenizer.c -o "$bin" || exit 1
+	printf '%s: ' "${flags:-default}"
+	"$bin" || exit 1
+done
@@ -0,0 +1,172 @@
+#include "../shell.h"
+
+/*
+ * Differential test of the word-at-a-time and SSE2 string routines
+ * against libc. Every string is tried at each alignment, and once
+ * ending on the last byte before an unmapped page, so that a routine
+ * reading past the terminator into the next page faults here rather
+ * than in the shell.
+ */
+
+#define TEST_MAX_LEN 300
+#define TEST_ALIGNS 64
+#define TEST_AREA 8192
+
+/**
+ * check - Reports a mismatch and exits, if a check failed.
+ * @ok: Non-zero if the check passed.
+ * @what: The routine checked.
+ * @len: The length of the string.
+ * @align: Its alignment, or -1 if it ended at the guard page.
+ */
+static void check(int ok, const char *what, size_t len, int align)
+{
+	if (!ok)
+	{
+		fprintf(stderr, "string_test: %s: length %lu, alignment %d\n",
+				what, (unsigned long)len, align);
+		exit(1);
+	}
+}
+
+/**
+ * check_search - Checks _strlen, _strchr, _memchr and scan_delim on a
+ * string.
+ * @s: The string.
+ * @len: Its length.
+ * @align: Its alignment, or -1 if it ends at the guard page.
+ */
+static void check_search(const char *s, size_t len, int align)
+{
+	static const char * const sets[] = {
+		" \t\n", ";&|<>", " \t\n;&|<>()`$=a"
+	};
+	static delim_set_t compiled[3];
+	int c, i;
+
+	check(_strlen(s) == len, "_strlen", len, align);
+	for (c = 0; c < 256; c += 5)
+	{
+		check(_strchr(s, c) == strchr(s, c), "_strchr", len, align);
+		check(_memchr(s, c, len) == memchr(s, c, len), "_memchr",
+				len, align);
+	}
+	if (len > 0)
+	{
+		c = (unsigned char)s[len - 1];
+		check(_strchr(s, c) == strchr(s, c), "_strchr", len, align);
+	}
+	for (i = 0; i < 3; i++)
+	{
+		if (!compiled[i].compiled)
+		{
+			delim_compile(&compiled[i], sets[i]);
+		}
+		check(scan_delim(&compiled[i], s) == s + strcspn(s, sets[i]),
+				"scan_delim", len, align);
+	}
+}
+
+/**
+ * check_compare - Checks _strcmp and _strncmp on two strings of the
+ * same length, equal and then differing in one byte.
+ * @s: The first string.
+ * @t: The second string; changed and restored.
+ * @len: Their length.
+ * @align: The alignment of @s, or -1 if it ends at the guard page.
+ */
+static void check_compare(const char *s, char *t, size_t len, int align)
+{
+	size_t n, at;
+
+	check(_strcmp(s, t) == 0 && _strncmp(s, t, len + 1) == 0,
+			"_strcmp equal", len, align);
+	for (at = 0; at < len; at += 1 + len / 7)
+	{
+		t[at] ^= 0x81;
+		check((_strcmp(s, t) > 0) == (strcmp(s, t) > 0)
+				&& _strcmp(s, t) != 0, "_strcmp", len, align);
+		for (n = 0; n <= len + 1; n += 1 + len / 11)
+		{
+			check((_strncmp(s, t, n) > 0) == (strncmp(s, t, n) > 0)
+					&& (_strncmp(s, t, n) == 0)
+					== (strncmp(s, t, n) == 0),
+					"_strncmp", len, align);
+		}
+		t[at] ^= 0x81;
+	}
+}
+
+/**
+ * check_copy - Checks _memcpy and _memmove against libc, copying
+ * between every pair of offsets a few bytes apart, overlapping both
+ * ways.
+ * @s: The source bytes.
+ * @len: The number of bytes.
+ * @align: The alignment of @s.
+ */
+static void check_copy(const char *s, size_t len, int align)
+{
+	static char got[TEST_AREA], want[TEST_AREA];
+	int shift;
+
+	memset(got, 0x55, len + 64);
+	_memcpy(got + align, s, len);
+	check(memcmp(got + align, s, len) == 0 && got[align + len] == 0x55,
+			"_memcpy", len, align);
+	for (shift = -17; shift <= 17; shift += 2)
+	{
+		memset(got, 0, len + 128);
+		memcpy(got + 32 + align, s, len);
+		memcpy(want, got, len + 128);
+		memmove(want + 32 + shift, want + 32 + align, len);
+		_memmove(got + 32 + shift, got + 32 + align, len);
+		check(memcmp(got, want, len + 128) == 0, "_memmove", len, align);
+	}
+}
+
+/**
+ * main - Runs the checks over every length and alignment.
+ * Return: 0 if every check passed; otherwise exits with 1.
+ */
+int main(void)
+{
+	static char area[2][TEST_AREA] __attribute__((aligned(4096)));
+	long page = sysconf(_SC_PAGESIZE);
+	char *map, *guard, *s, *t;
+	size_t len, i;
+	int align;
+
+	map = mmap(NULL, page * 2, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED || mprotect(map + page, page, PROT_NONE) != 0)
+	{
+		perror("string_test");
+		return (1);
+	}
+	guard = map + page;
+	srand(1);
+	for (len = 0; len <= TEST_MAX_LEN; len++)
+	{
+		for (align = 0; align < TEST_ALIGNS; align++)
+		{
+			s = area[0] + align;
+			t = area[1] + (align * 7 + len) % TEST_ALIGNS;
+			for (i = 0; i < len; i++)
+			{
+				s[i] = 1 + rand() % 255;
+			}
+			s[len] = '\0';
+			memcpy(t, s, len + 1);
+			check_search(s, len, align);
+			check_compare(s, t, len, align);
+			check_copy(s, len, align);
+		}
+		memcpy(guard - len - 1, s, len + 1);
+		check_search(guard - len - 1, len, -1);
+		check_compare(guard - len - 1, t, len, -1);
+		check_compare(t, guard - len - 1, len, -1);
+	}
+	printf("string_test: ok\n");
+	return (0);
+}
@@ -0,0 +1,132 @@
+#include "shell.h"
+
+/**
+ * delim_compile - Compiles a set of delimiter characters into a
+ * 256-bit lookup bitmap, so testing a byte costs one load and a shift.
+ * @set: The set to fill in.
+ * @delims: The delimiter characters.
+ */
+void delim_compile(delim_set_t *set, const char *delims)
+{
+	unsigned char c;
+	size_t i;
+
+	for (i = 0; i < DELIM_WORDS; i++)
+	{
+		set->bits[i] = 0;
+	}
+	set->nchars = 0;
+	for (; *delims != '\0'; delims++)
+	{
+		c = (unsigned char)*delims;
+		set->bits[c / DELIM_BITS] |= 1UL << (c % DELIM_BITS);
+		if (set->nchars < DELIM_SIMD_MAX)
+		{
+			set->chars[set->nchars] = *delims;
+		}
+		set->nchars++;
+	}
+	set->compiled = 1;
+}
+
+#ifdef __SSE2__
+/**
+ * scan_delim_sse2 - Finds the end of a token 16 bytes at a time.
+ *
+ * Loads are 16-byte aligned, so they never cross into a page the
+ * string does not touch, even when they read past its terminator.
+ * @set: The delimiter set (at most DELIM_SIMD_MAX characters).
+ * @p: Where to start scanning.
+ * Return: A pointer to the first delimiter or NUL byte.
+ */
+NO_ASAN static const char *scan_delim_sse2(const delim_set_t *set,
+		const char *p)
+{
+	const __m128i *block = (const __m128i *)((size_t)p & ~(size_t)15);
+	unsigned int mask, skip = (size_t)p & 15;
+	__m128i v, hit, want[DELIM_SIMD_MAX];
+	int i;
+
+	for (i = 0; i < set->nchars; i++)
+	{
+		want[i] = _mm_set1_epi8(set->chars[i]);
+	}
+	for (;; block++)
+	{
+		v = _mm_load_si128(block);
+		hit = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+		for (i = 0; i < set->nchars; i++)
+		{
+			hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, want[i]));
+		}
+		mask = (unsigned int)_mm_movemask_epi8(hit);
+		mask &= 0xffffu << skip;
+		skip = 0;
+		if (mask != 0)
+		{
+			return ((const char *)block + __builtin_ctz(mask));
+		}
+	}
+}
+#endif
+
+/**
+ * scan_delim - Finds the end of a token.
+ *
+ * Most tokens are short, so the first 16 bytes, and any more up to a
+ * 16-byte boundary, are checked one at a time against the bitmap; only
+ * a longer token pays for setting up the SSE2 scan.
+ * @set: The delimiter set.
+ * @p: Where to start scanning.
+ * Return: A pointer to the first delimiter or NUL byte.
+ */
+const char *scan_delim(const delim_set_t *set, const char *p)
+{
+#ifdef __SSE2__
+	const char *start = p;
+
+	for (; p - start < 16 || (size_t)p % 16 != 0; p++)
+	{
+		if (*p == '\0' || DELIM_HAS(set, *p))
+		{
+			return (p);
+		}
+	}
+	if (set->nchars <= DELIM_SIMD_MAX)
+	{
+		return (scan_delim_sse2(set, p));
+	}
+#endif
+	while (*p != '\0' && !DELIM_HAS(set, *p))
+	{
+		p++;
+	}
+	return (p);
+}
+
+/**
+ * next_token - Finds the next token in a string without modifying it.
+ * @set: The compiled delimiter set.
+ * @cursor: The scan position; advanced to the byte after the token.
+ * @tok: Where to store the token's start and length.
+ * Return: 1 if a token was found, 0 at the end of the string.
+ */
+int next_token(const delim_set_t *set, const char **cursor, span_t *tok)
+{
+	const char *p = *cursor;
+
+	while (*p != '\0' && DELIM_HAS(set, *p))
+	{
+		p++;
+	}
+	if (*p == '\0')
+	{
+		*cursor = p;
+		return (0);
+	}
+	tok->start = p;
+	p = scan_delim(set, p + 1);
+	tok->len = p - tok->start;
+	*cursor = p;
+	return (1);
+}
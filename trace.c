@@ -0,0 +1,74 @@
+#include "shell.h"
+
+/*
+ * Non-zero when HSH_TRACE is set. A plain global rather than a field
+ * behind an accessor, so that each trace point costs one load and one
+ * predicted-not-taken branch when tracing is off.
+ */
+int trace_enabled;
+
+/**
+ * get_trace - Returns the trace counters.
+ * Return: A pointer to the counters.
+ */
+trace_t *get_trace(void)
+{
+	static trace_t trace;
+
+	return (&trace);
+}
+
+/**
+ * trace_clock - Reads the monotonic clock.
+ * Return: The time in nanoseconds.
+ */
+unsigned long trace_clock(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((unsigned long)now.tv_sec * 1000000000UL + now.tv_nsec);
+}
+
+/**
+ * trace_init - Turns tracing on if HSH_TRACE is set: a descriptor
+ * number gets one JSON line per input line, anything else gets the
+ * per-stage histograms on the standard error stream at exit.
+ */
+void trace_init(void)
+{
+	const char *value = _getenv("HSH_TRACE");
+	trace_t *trace = get_trace();
+	int i;
+
+	if (value == NULL || *value == '\0')
+	{
+		return;
+	}
+	for (i = 0; value[i] >= '0' && value[i] <= '9'; i++)
+		;
+	trace->fd = value[i] == '\0' ? _atoi(value) : -1;
+	if (trace->fd == -1)
+	{
+		atexit(trace_report);
+	}
+	trace_enabled = 1;
+}
+
+/**
+ * trace_record - Records the time spent in a stage, in its histogram
+ * and in the current line's totals.
+ * @stage: The stage (one of the TRACE_ constants).
+ * @start: The trace_clock() reading when the stage began.
+ */
+void trace_record(int stage, unsigned long start)
+{
+	trace_t *trace = get_trace();
+	unsigned long ns = trace_clock() - start;
+	int bucket = (int)(sizeof(long) * 8 - 1) - __builtin_clzl(ns | 1);
+
+	trace->hist[stage][bucket]++;
+	trace->count[stage]++;
+	trace->total[stage] += ns;
+	trace->line[stage] += ns;
+}
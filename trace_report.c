@@ -0,0 +1,157 @@
+#include "shell.h"
+
+/* The stage names, indexed by the TRACE_ constants. */
+static const char * const stage_names[TRACE_STAGES] = {
+	"read_line", "split_input", "expand", "dispatch",
+	"get_full_path", "spawn", "wait"
+};
+
+/**
+ * trace_ultoa - Converts an unsigned long to a decimal string.
+ * @num: The number.
+ * @buf: Where to store the string; at least TRACE_NUM_SIZE bytes.
+ * Return: @buf.
+ */
+static char *trace_ultoa(unsigned long num, char *buf)
+{
+	char digits[TRACE_NUM_SIZE];
+	int i = 0, j = 0;
+
+	do {
+		digits[i++] = '0' + num % 10;
+		num /= 10;
+	} while (num != 0);
+	while (i > 0)
+	{
+		buf[j++] = digits[--i];
+	}
+	buf[j] = '\0';
+	return (buf);
+}
+
+/**
+ * trace_percentile - Finds the histogram bucket holding a percentile.
+ * @stage: The stage.
+ * @percent: The percentile.
+ * Return: The upper bound of the bucket in nanoseconds, exclusive.
+ */
+static unsigned long trace_percentile(int stage, unsigned long percent)
+{
+	trace_t *trace = get_trace();
+	unsigned long rank, seen = 0;
+	int bucket;
+
+	rank = (trace->count[stage] * percent + 99) / 100;
+	for (bucket = 0; bucket < TRACE_BUCKETS - 1; bucket++)
+	{
+		seen += trace->hist[stage][bucket];
+		if (seen >= rank)
+		{
+			break;
+		}
+	}
+	return (2UL << bucket);
+}
+
+/**
+ * trace_report - Prints, at exit, each traced stage's call count, total
+ * time, p50 and p99, and its log-scale histogram: one row per
+ * power-of-two range of nanoseconds that holds any calls. A forked
+ * child that calls exit() prints nothing.
+ */
+void trace_report(void)
+{
+	trace_t *trace = get_trace();
+	const char *parts[12];
+	char nums[4][TRACE_NUM_SIZE];
+	int stage, b;
+
+	stage = getpid() == get_shell()->pid ? 0 : TRACE_STAGES;
+	for (; stage < TRACE_STAGES; stage++)
+	{
+		if (trace->count[stage] == 0)
+		{
+			continue;
+		}
+		parts[0] = "hsh: trace: ";
+		parts[1] = stage_names[stage];
+		parts[2] = ": ";
+		parts[3] = trace_ultoa(trace->count[stage], nums[0]);
+		parts[4] = " calls, total ";
+		parts[5] = trace_ultoa(trace->total[stage], nums[1]);
+		parts[6] = " ns, p50 < ";
+		parts[7] = trace_ultoa(trace_percentile(stage, 50), nums[2]);
+		parts[8] = " ns, p99 < ";
+		parts[9] = trace_ultoa(trace_percentile(stage, 99), nums[3]);
+		parts[10] = " ns\n";
+		write_err(parts, 11);
+		for (b = 0; b < TRACE_BUCKETS; b++)
+		{
+			if (trace->hist[stage][b] != 0)
+			{
+				parts[0] = "  < ";
+				parts[1] = trace_ultoa(2UL << b, nums[0]);
+				parts[2] = " ns: ";
+				parts[3] = trace_ultoa(trace->hist[stage][b],
+						nums[1]);
+				parts[4] = "\n";
+				write_err(parts, 5);
+			}
+		}
+	}
+}
+
+/**
+ * trace_command_end - Writes the time each stage took on the command
+ * just run as one JSON object, when tracing to a descriptor, and
+ * clears it. The object gives the command's input line and its
+ * position on that line.
+ */
+void trace_command_end(void)
+{
+	trace_t *trace = get_trace();
+	char text[TRACE_STAGES * (TRACE_NUM_SIZE + 20) + 64];
+	char num[TRACE_NUM_SIZE];
+	int stage;
+
+	if (trace->fd == -1)
+	{
+		return;
+	}
+	if (trace->line_no != get_shell()->line_count)
+	{
+		trace->line_no = get_shell()->line_count;
+		trace->command = 0;
+	}
+	_strcpy(text, "{\"line\":");
+	_strcat(text, trace_ultoa(trace->line_no, num));
+	_strcat(text, ",\"command\":");
+	_strcat(text, trace_ultoa(++trace->command, num));
+	for (stage = 0; stage < TRACE_STAGES; stage++)
+	{
+		_strcat(text, ",\"");
+		_strcat(text, stage_names[stage]);
+		_strcat(text, "\":");
+		_strcat(text, trace_ultoa(trace->line[stage], num));
+		trace->line[stage] = 0;
+	}
+	_strcat(text, "}\n");
+	_flush_out();
+	write(trace->fd, text, _strlen(text));
+}
+
+/**
+ * trace_line_end - Drops the time spent reading and splitting a line
+ * that ran no command, such as a blank line or a syntax error, so
+ * that it is not counted towards the next line's first command.
+ */
+void trace_line_end(void)
+{
+	trace_t *trace = get_trace();
+	int stage;
+
+	for (stage = 0; stage < TRACE_STAGES; stage++)
+	{
+		trace->line[stage] = 0;
+	}
+}